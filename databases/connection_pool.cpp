@@ -0,0 +1,143 @@
+#include "connection_pool.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+Connection::Connection(const std::string& db_path, int flags)
+    : db_(db_path, flags), statements_(db_), read_only_((flags & SQLite::OPEN_READONLY) != 0) {
+}
+
+void Connection::applyProfile(const StorageProfile& profile, size_t generation) {
+    // journal_mode is persistent in the database file and needs write access
+    if (!read_only_) {
+        db_.exec("PRAGMA journal_mode = " + profile.journal_mode);
+    }
+    db_.exec("PRAGMA synchronous = " + profile.synchronous);
+    // A negative cache_size is in KiB instead of pages
+    db_.exec("PRAGMA cache_size = -" + std::to_string(profile.cache_size_kib));
+    db_.exec("PRAGMA mmap_size = " + std::to_string(profile.mmap_size));
+    db_.exec("PRAGMA temp_store = " + profile.temp_store);
+    db_.setBusyTimeout(profile.busy_timeout_ms);
+    profile_generation_ = generation;
+}
+
+ConnectionPool::Lease::Lease(ConnectionPool& pool, Connection& connection, bool writer)
+    : pool_(&pool), connection_(&connection), writer_(writer) {
+}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), connection_(other.connection_), writer_(other.writer_) {
+    other.pool_ = nullptr;
+    other.connection_ = nullptr;
+}
+
+ConnectionPool::Lease::~Lease() {
+    if (pool_ != nullptr) {
+        pool_->release(*connection_, writer_);
+    }
+}
+
+ConnectionPool::ConnectionPool(const std::string& db_path, size_t max_readers, const StorageProfile& profile)
+    : db_path_(db_path), max_readers_(max_readers > 0 ? max_readers : 1),
+    writer_(db_path, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE), profile_(profile) {
+    spdlog::info("ConnectionPool initialized with database: {}, max readers: {}", db_path_, max_readers_);
+    applyProfile(profile);
+}
+
+void ConnectionPool::applyProfile(const StorageProfile& profile) {
+    std::lock_guard<std::recursive_mutex> writer_lock(writer_mutex_);
+    size_t generation;
+    {
+        std::lock_guard<std::mutex> lock(readers_mutex_);
+        profile_ = profile;
+        generation = ++profile_generation_;
+    }
+    try {
+        writer_.applyProfile(profile, generation);
+        spdlog::info("Applied storage profile '{}'", profile.name);
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to apply storage profile '{}': {}", profile.name, e.what());
+    }
+}
+
+StorageProfile ConnectionPool::profile() {
+    std::lock_guard<std::mutex> lock(readers_mutex_);
+    return profile_;
+}
+
+ConnectionPool::Lease ConnectionPool::writer() {
+    writer_mutex_.lock();
+    return Lease(*this, writer_, true);
+}
+
+ConnectionPool::Lease ConnectionPool::reader() {
+    std::unique_lock<std::mutex> lock(readers_mutex_);
+    Connection* connection;
+    if (idle_readers_.empty() && readers_.size() < max_readers_) {
+        readers_.push_back(std::make_unique<Connection>(db_path_, SQLite::OPEN_READONLY));
+        connection = readers_.back().get();
+        spdlog::debug("Opened read-only connection {} of {}", readers_.size(), max_readers_);
+    }
+    else {
+        readers_cv_.wait(lock, [this] { return !idle_readers_.empty(); });
+        connection = idle_readers_.back();
+        idle_readers_.pop_back();
+    }
+    StorageProfile profile = profile_;
+    size_t generation = profile_generation_;
+    lock.unlock();
+
+    Lease lease(*this, *connection, false);
+    if (connection->profileGeneration() != generation) {
+        try {
+            connection->applyProfile(profile, generation);
+        }
+        catch (const SQLite::Exception& e) {
+            spdlog::warn("Failed to apply storage profile '{}' to reader: {}", profile.name, e.what());
+        }
+    }
+    return lease;
+}
+
+void ConnectionPool::release(Connection& connection, bool writer) {
+    if (writer) {
+        writer_mutex_.unlock();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(readers_mutex_);
+        idle_readers_.push_back(&connection);
+    }
+    readers_cv_.notify_one();
+}
+
+void ConnectionPool::logStatistics() {
+    auto log_cache = [](const std::string& name, const StatementCache& cache) {
+        spdlog::info("Statement cache [{}]: {} cached, {} hits, {} misses",
+            name, cache.size(), cache.hits(), cache.misses());
+    };
+    {
+        std::lock_guard<std::recursive_mutex> lock(writer_mutex_);
+        log_cache("writer", writer_.statements());
+    }
+    // An idle reader cannot be checked out while readers_mutex_ is held; a
+    // borrowed one is in use on another thread, so its cache is not read
+    std::lock_guard<std::mutex> lock(readers_mutex_);
+    for (size_t i = 0; i < readers_.size(); ++i) {
+        const std::string name = "reader " + std::to_string(i + 1);
+        if (std::find(idle_readers_.begin(), idle_readers_.end(), readers_[i].get()) == idle_readers_.end()) {
+            spdlog::info("Statement cache [{}]: in use, skipped", name);
+            continue;
+        }
+        log_cache(name, readers_[i]->statements());
+    }
+}
+
+ScopedStorageProfile::ScopedStorageProfile(ConnectionPool& pool, const StorageProfile& profile)
+    : pool_(pool), previous_(pool.profile()) {
+    pool_.applyProfile(profile);
+}
+
+ScopedStorageProfile::~ScopedStorageProfile() {
+    pool_.applyProfile(previous_);
+}
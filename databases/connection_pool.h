@@ -0,0 +1,92 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <SQLiteCpp/SQLiteCpp.h>
+#include "statement_cache.h"
+#include "storage_profile.h"
+
+// One SQLite connection together with the statements prepared on it
+class Connection {
+private:
+    SQLite::Database db_;
+    StatementCache statements_;
+    bool read_only_;
+    size_t profile_generation_ = 0;
+
+public:
+    Connection(const std::string& db_path, int flags);
+    void applyProfile(const StorageProfile& profile, size_t generation);
+    size_t profileGeneration() const { return profile_generation_; }
+    SQLite::Database& db() { return db_; }
+    StatementCache& statements() { return statements_; }
+};
+
+// Connections of one database file shared by all repositories: a single
+// writer connection plus a bounded set of lazily opened read-only ones
+class ConnectionPool {
+public:
+    // Borrowed connection, returned to the pool when the lease is destroyed
+    class Lease {
+    private:
+        ConnectionPool* pool_;
+        Connection* connection_;
+        bool writer_;
+
+    public:
+        Lease(ConnectionPool& pool, Connection& connection, bool writer);
+        Lease(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        Connection& operator*() { return *connection_; }
+        Connection* operator->() { return connection_; }
+    };
+
+    ConnectionPool(const std::string& db_path = "library.db", size_t max_readers = 4,
+        const StorageProfile& profile = StorageProfile::interactive());
+
+    // The writer is re-entrant for the owning thread, so a repository method
+    // holding it may call another one that takes it again
+    Lease writer();
+    // Blocks while all max_readers read-only connections are borrowed
+    Lease reader();
+
+    const std::string& path() const { return db_path_; }
+    size_t maxReaders() const { return max_readers_; }
+    // Applied to the writer at once and to each reader on its next checkout
+    void applyProfile(const StorageProfile& profile);
+    StorageProfile profile();
+    // Logs the statement cache counters; readers borrowed at the time are skipped
+    void logStatistics();
+
+private:
+    std::string db_path_;
+    size_t max_readers_;
+    Connection writer_;
+    std::recursive_mutex writer_mutex_;
+    std::mutex readers_mutex_;
+    std::condition_variable readers_cv_;
+    std::vector<std::unique_ptr<Connection>> readers_;
+    std::vector<Connection*> idle_readers_;
+    StorageProfile profile_;
+    size_t profile_generation_ = 0;
+
+    void release(Connection& connection, bool writer);
+};
+
+// Switches the pool to another profile for the lifetime of the object
+class ScopedStorageProfile {
+private:
+    ConnectionPool& pool_;
+    StorageProfile previous_;
+
+public:
+    ScopedStorageProfile(ConnectionPool& pool, const StorageProfile& profile);
+    ~ScopedStorageProfile();
+    ScopedStorageProfile(const ScopedStorageProfile&) = delete;
+    ScopedStorageProfile& operator=(const ScopedStorageProfile&) = delete;
+};
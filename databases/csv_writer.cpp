@@ -0,0 +1,54 @@
+#include "csv_writer.h"
+
+CSVWriter::CSVWriter(const std::string& path, size_t buffer_size) : out_(path, buffer_size) {
+}
+
+void CSVWriter::writeRaw(std::string_view data) {
+    out_.append(data);
+    out_.maybeFlush();
+}
+
+void CSVWriter::separator() {
+    if (row_started_) {
+        out_.append(',');
+    }
+    row_started_ = true;
+}
+
+void CSVWriter::field(std::string_view value) {
+    separator();
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out_.append(value);
+        return;
+    }
+    out_.append('"');
+    size_t start = 0;
+    for (size_t quote = value.find('"'); quote != std::string_view::npos; quote = value.find('"', start)) {
+        out_.append(value.substr(start, quote + 1 - start));
+        out_.append('"');
+        start = quote + 1;
+    }
+    out_.append(value.substr(start));
+    out_.append('"');
+}
+
+void CSVWriter::field(long long value) {
+    separator();
+    out_.append(value);
+}
+
+void CSVWriter::field(const SQLite::Column& column) {
+    if (column.isInteger()) {
+        field(static_cast<long long>(column.getInt64()));
+    }
+    else {
+        field(std::string_view(column.getText(), column.getBytes()));
+    }
+}
+
+void CSVWriter::endRow() {
+    out_.append('\n');
+    row_started_ = false;
+    ++rows_;
+    out_.maybeFlush();
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <SQLiteCpp/SQLiteCpp.h>
+#include "output_buffer.h"
+
+// Streaming CSV writer: fields are escaped straight into one reusable
+// output buffer, so memory use does not depend on the number of rows
+class CSVWriter {
+private:
+    OutputBuffer out_;
+    size_t rows_ = 0;
+    bool row_started_ = false;
+
+    void separator();
+
+public:
+    explicit CSVWriter(const std::string& path, size_t buffer_size = 1 << 20);
+
+    bool isOpen() const { return out_.isOpen(); }
+    void writeRaw(std::string_view data);
+    // RFC 4180: quote fields with separators, quotes or line breaks, double inner quotes
+    void field(std::string_view value);
+    void field(long long value);
+    // Integer columns are formatted directly, everything else as text
+    void field(const SQLite::Column& column);
+    void endRow();
+    void close() { out_.close(); }
+    size_t rows() const { return rows_; }
+};
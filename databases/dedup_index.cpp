@@ -0,0 +1,92 @@
+#include "dedup_index.h"
+
+namespace {
+    // 0 marks an empty slot, so it is remapped
+    uint64_t storedKey(uint64_t key) {
+        return key == 0 ? 1 : key;
+    }
+}
+
+uint64_t KeyHash::mix(uint64_t x) {
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+KeyHash& KeyHash::add(std::string_view text) {
+    // FNV-1a over the bytes, seeded with the running value
+    uint64_t hash = value_ ^ 0xCBF29CE484222325ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    value_ = mix(hash ^ text.size());
+    return *this;
+}
+
+KeyHash& KeyHash::add(long long number) {
+    value_ = mix(value_ ^ (static_cast<uint64_t>(number) + 0x632BE59BD9B4E019ull));
+    return *this;
+}
+
+void DedupIndex::reset(size_t expected) {
+    size_t capacity = 16;
+    while (capacity < expected * 2) capacity <<= 1;
+    slots_.assign(capacity, 0);
+    size_ = 0;
+    checks_ = 0;
+    fallbacks_ = 0;
+    loaded_ = true;
+}
+
+void DedupIndex::unload() {
+    std::vector<uint64_t>().swap(slots_);
+    size_ = 0;
+    loaded_ = false;
+}
+
+void DedupIndex::place(uint64_t key) {
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = key & mask;; i = (i + 1) & mask) {
+        if (slots_[i] == key) return;
+        if (slots_[i] == 0) {
+            slots_[i] = key;
+            ++size_;
+            return;
+        }
+    }
+}
+
+void DedupIndex::grow() {
+    std::vector<uint64_t> old;
+    old.swap(slots_);
+    slots_.assign(old.size() * 2, 0);
+    size_ = 0;
+    for (uint64_t key : old) {
+        if (key != 0) place(key);
+    }
+}
+
+bool DedupIndex::mayContain(uint64_t key) {
+    if (!loaded_) return true;
+    key = storedKey(key);
+    ++checks_;
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = key & mask;; i = (i + 1) & mask) {
+        if (slots_[i] == key) {
+            ++fallbacks_;
+            return true;
+        }
+        if (slots_[i] == 0) return false;
+    }
+}
+
+void DedupIndex::insert(uint64_t key) {
+    if (!loaded_) return;
+    if ((size_ + 1) * 2 > slots_.size()) grow();
+    place(storedKey(key));
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// 64-bit hash of a tuple of key columns. Every value is mixed in with its
+// length, so ("ab", "c") and ("a", "bc") give different keys.
+class KeyHash {
+private:
+    uint64_t value_ = 0x9E3779B97F4A7C15ull;
+
+    static uint64_t mix(uint64_t x);
+
+public:
+    KeyHash& add(std::string_view text);
+    KeyHash& add(long long number);
+    uint64_t value() const { return value_; }
+};
+
+// Import-time set of the keys already stored in a table.
+// Open addressing with linear probing over a flat array of hashes, kept at
+// most half full. A miss proves the row is new, so the *Exists SELECT is
+// skipped; a hit may be a hash collision and is confirmed in the database.
+// Not thread-safe: Repository only touches it while holding the writer lease.
+class DedupIndex {
+private:
+    std::vector<uint64_t> slots_;
+    size_t size_ = 0;
+    bool loaded_ = false;
+    size_t checks_ = 0;
+    size_t fallbacks_ = 0;
+
+    void grow();
+    void place(uint64_t key);
+
+public:
+    // Empties the index and starts using it, sized for expected keys
+    void reset(size_t expected);
+    // Stops using the index and releases its memory
+    void unload();
+    bool loaded() const { return loaded_; }
+
+    // True if the key may be present; false means it is certainly absent
+    bool mayContain(uint64_t key);
+    void insert(uint64_t key);
+
+    size_t size() const { return size_; }
+    size_t checks() const { return checks_; }
+    size_t fallbacks() const { return fallbacks_; }
+};
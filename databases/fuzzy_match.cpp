@@ -0,0 +1,158 @@
+#include "fuzzy_match.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    constexpr char32_t replacement_character = 0xFFFD;
+
+    // Decodes the code point at pos and moves pos past it
+    char32_t nextCodePoint(std::string_view text, size_t& pos) {
+        const unsigned char lead = static_cast<unsigned char>(text[pos++]);
+        if (lead < 0x80) {
+            return lead;
+        }
+        size_t extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+        if (extra == 0 || lead > 0xF4 || pos + extra > text.size()) {
+            return replacement_character;
+        }
+        char32_t code = lead & (0x3F >> extra);
+        for (size_t i = 0; i < extra; ++i) {
+            const unsigned char next = static_cast<unsigned char>(text[pos]);
+            if ((next & 0xC0) != 0x80) {
+                return replacement_character;
+            }
+            code = (code << 6) | (next & 0x3F);
+            ++pos;
+        }
+        return code;
+    }
+
+    char32_t foldCase(char32_t c) {
+        if ((c >= U'A' && c <= U'Z') || (c >= 0xC0 && c <= 0xDE && c != 0xD7) || (c >= 0x410 && c <= 0x42F)) {
+            return c + 0x20;
+        }
+        if (c >= 0x400 && c <= 0x40F) {
+            return c + 0x50;  // Ё, Є, І, Ї, ...
+        }
+        return c;
+    }
+
+    bool isSpace(char32_t c) {
+        return c == U' ' || c == U'\t' || c == U'\n' || c == U'\r' || c == 0xA0;
+    }
+
+    // Quotes text as one FTS5 string
+    void appendQuoted(std::string& out, std::string_view text) {
+        out += '"';
+        for (char c : text) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+
+    struct Word {
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<Word> splitWords(std::u32string_view text) {
+        std::vector<Word> words;
+        size_t i = 0;
+        while (i < text.size()) {
+            while (i < text.size() && isSpace(text[i])) ++i;
+            const size_t begin = i;
+            while (i < text.size() && !isSpace(text[i])) ++i;
+            if (i > begin) {
+                words.push_back(Word{ begin, i });
+            }
+        }
+        return words;
+    }
+}
+
+namespace fuzzy {
+    std::u32string fold(std::string_view text) {
+        std::u32string folded;
+        folded.reserve(text.size());
+        size_t pos = 0;
+        while (pos < text.size()) {
+            folded += foldCase(nextCodePoint(text, pos));
+        }
+        return folded;
+    }
+
+    size_t editDistance(std::u32string_view a, std::u32string_view b, size_t cutoff) {
+        if (a.size() > b.size()) {
+            std::swap(a, b);
+        }
+        if (b.size() - a.size() > cutoff) {
+            return cutoff + 1;
+        }
+        // Two rows of the DP table over the shorter string
+        std::vector<size_t> previous(a.size() + 1), current(a.size() + 1);
+        for (size_t i = 0; i <= a.size(); ++i) {
+            previous[i] = i;
+        }
+        for (size_t j = 1; j <= b.size(); ++j) {
+            current[0] = j;
+            size_t row_min = j;
+            for (size_t i = 1; i <= a.size(); ++i) {
+                const size_t substitute = previous[i - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+                current[i] = std::min({ previous[i] + 1, current[i - 1] + 1, substitute });
+                row_min = std::min(row_min, current[i]);
+            }
+            // Distances never shrink from one row to the next
+            if (row_min > cutoff) {
+                return cutoff + 1;
+            }
+            std::swap(previous, current);
+        }
+        return std::min(previous[a.size()], cutoff + 1);
+    }
+
+    size_t nameDistance(std::u32string_view query, std::u32string_view name, size_t cutoff) {
+        size_t best = editDistance(query, name, cutoff);
+        const size_t query_words = std::max<size_t>(1, splitWords(query).size());
+        const std::vector<Word> words = splitWords(name);
+        for (size_t i = 0; i + query_words <= words.size() && best > 0; ++i) {
+            const size_t begin = words[i].begin;
+            const size_t end = words[i + query_words - 1].end;
+            best = std::min(best, editDistance(query, name.substr(begin, end - begin), best));
+        }
+        return best;
+    }
+
+    std::string prefixQuery(std::string_view text) {
+        std::string expression = "^";
+        appendQuoted(expression, text);
+        return expression;
+    }
+
+    std::string trigramQuery(std::string_view text) {
+        // Byte offset of every code point, plus the end
+        std::vector<size_t> offsets;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            offsets.push_back(pos);
+            nextCodePoint(text, pos);
+        }
+        offsets.push_back(text.size());
+
+        std::vector<std::u32string> seen;
+        std::string expression;
+        for (size_t i = 0; i + 3 < offsets.size(); ++i) {
+            const std::string_view trigram = text.substr(offsets[i], offsets[i + 3] - offsets[i]);
+            std::u32string folded = fold(trigram);
+            if (std::find(seen.begin(), seen.end(), folded) != seen.end()) {
+                continue;
+            }
+            seen.push_back(std::move(folded));
+            if (!expression.empty()) {
+                expression += " OR ";
+            }
+            appendQuoted(expression, trigram);
+        }
+        return expression;
+    }
+}
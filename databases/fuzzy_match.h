@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Name matching for prefix and typo-tolerant lookups. Text is compared as
+// Unicode code points with case folded, so "лев толстой" finds "Лев Толстой".
+namespace fuzzy {
+    // Code points in a trigram; shorter text cannot be looked up by similarity
+    inline constexpr size_t min_similar_length = 3;
+
+    // Code points of UTF-8 text with ASCII, Latin-1 and Cyrillic letters in
+    // lower case; malformed bytes become U+FFFD
+    std::u32string fold(std::string_view text);
+
+    // Levenshtein distance, or cutoff + 1 as soon as it must exceed cutoff
+    size_t editDistance(std::u32string_view a, std::u32string_view b, size_t cutoff);
+
+    // Distance of query to the whole name or to any run of as many words of
+    // it, whichever is smaller, so "tolstoi" is one edit from "Leo Tolstoy"
+    size_t nameDistance(std::u32string_view query, std::u32string_view name, size_t cutoff);
+
+    // FTS5 expression for a trigram index matching names that start with text
+    std::string prefixQuery(std::string_view text);
+
+    // FTS5 expression matching any trigram of text; bm25 ranks names sharing
+    // the most trigrams first
+    std::string trigramQuery(std::string_view text);
+}
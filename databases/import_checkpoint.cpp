@@ -0,0 +1,104 @@
+#include "import_checkpoint.h"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+
+namespace {
+    // Size and modification time identify the version of a file
+    bool fileIdentity(const std::string& file, long long& size, long long& modified) {
+        std::error_code error;
+        auto file_size = std::filesystem::file_size(file, error);
+        if (error) return false;
+        auto write_time = std::filesystem::last_write_time(file, error);
+        if (error) return false;
+        size = static_cast<long long>(file_size);
+        modified = static_cast<long long>(write_time.time_since_epoch().count());
+        return true;
+    }
+}
+
+CheckpointStore::CheckpointStore(ConnectionPool& pool) : pool_(pool) {
+}
+
+bool CheckpointStore::initialize() {
+    try {
+        auto conn = pool_.writer();
+        conn->db().exec(
+            "CREATE TABLE IF NOT EXISTS import_checkpoint ("
+            "file TEXT PRIMARY KEY, "
+            "file_size INTEGER NOT NULL, "
+            "modified INTEGER NOT NULL, "
+            "byte_offset INTEGER NOT NULL, "
+            "row_number INTEGER NOT NULL, "
+            "updated_at TEXT NOT NULL DEFAULT CURRENT_TIMESTAMP)"
+        );
+        spdlog::info("Import checkpoint table initialized");
+        return true;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to initialize import checkpoint table: {}", e.what());
+        return false;
+    }
+}
+
+std::optional<ImportPosition> CheckpointStore::find(const std::string& file) {
+    try {
+        long long size = 0;
+        long long modified = 0;
+        if (!fileIdentity(file, size, modified)) {
+            return std::nullopt;
+        }
+        auto conn = pool_.writer();
+        auto query = conn->statements().get("SELECT file_size, modified, byte_offset, row_number FROM import_checkpoint WHERE file = ?");
+        query->bind(1, file);
+        if (!query->executeStep()) {
+            return std::nullopt;
+        }
+        if (query->getColumn(0).getInt64() != size || query->getColumn(1).getInt64() != modified) {
+            spdlog::warn("Ignoring checkpoint for {}: the file has changed since", file);
+            return std::nullopt;
+        }
+        ImportPosition position;
+        position.offset = static_cast<size_t>(query->getColumn(2).getInt64());
+        position.row = static_cast<size_t>(query->getColumn(3).getInt64());
+        spdlog::info("Found checkpoint for {} at row {} (byte {})", file, position.row, position.offset);
+        return position;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to read checkpoint for {}: {}", file, e.what());
+        return std::nullopt;
+    }
+}
+
+void CheckpointStore::store(Connection& conn, const std::string& file, const ImportPosition& position) {
+    long long size = 0;
+    long long modified = 0;
+    if (!fileIdentity(file, size, modified)) {
+        return;
+    }
+    // Errors propagate so the surrounding batch is rolled back with its checkpoint
+    auto query = conn.statements().get(
+        "INSERT INTO import_checkpoint (file, file_size, modified, byte_offset, row_number) VALUES (?, ?, ?, ?, ?) "
+        "ON CONFLICT(file) DO UPDATE SET file_size = excluded.file_size, modified = excluded.modified, "
+        "byte_offset = excluded.byte_offset, row_number = excluded.row_number, updated_at = CURRENT_TIMESTAMP");
+    query->bind(1, file);
+    query->bind(2, static_cast<int64_t>(size));
+    query->bind(3, static_cast<int64_t>(modified));
+    query->bind(4, static_cast<int64_t>(position.offset));
+    query->bind(5, static_cast<int64_t>(position.row));
+    query->exec();
+    spdlog::debug("Checkpoint for {} at row {} (byte {})", file, position.row, position.offset);
+}
+
+bool CheckpointStore::clear(const std::string& file) {
+    try {
+        auto conn = pool_.writer();
+        auto query = conn->statements().get("DELETE FROM import_checkpoint WHERE file = ?");
+        query->bind(1, file);
+        query->exec();
+        return true;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to clear checkpoint for {}: {}", file, e.what());
+        return false;
+    }
+}
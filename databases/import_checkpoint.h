@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include <optional>
+#include "connection_pool.h"
+#include "import_position.h"
+
+// Progress of interrupted imports, kept in the import_checkpoint table.
+// A position is stored in the same transaction as the batch it follows, so
+// it never points past rows that are not in the database. Entries are tied
+// to the file's size and modification time and ignored once it changes.
+class CheckpointStore {
+private:
+    ConnectionPool& pool_;
+
+public:
+    explicit CheckpointStore(ConnectionPool& pool);
+    bool initialize();
+    // Position to resume the file from, if an unfinished import was recorded
+    std::optional<ImportPosition> find(const std::string& file);
+    // Must be called inside the transaction of the batch that ends at position
+    void store(Connection& conn, const std::string& file, const ImportPosition& position);
+    // Forgets the file once it was imported completely
+    bool clear(const std::string& file);
+};
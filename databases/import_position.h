@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+class Connection;
+
+// Where an import stands after a row: byte offset of the next record in
+// the file and the number of data rows read up to it
+struct ImportPosition {
+    size_t offset = 0;
+    size_t row = 0;
+};
+
+// Runs inside a batch transaction just before it commits
+using BatchCommitHook = std::function<void(Connection&)>;
+
+// A batch could not be written; the import stops so its checkpoint stays
+// at the last committed batch
+class ImportWriteError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
@@ -0,0 +1,88 @@
+#include "index_advisor.h"
+#include <spdlog/spdlog.h>
+
+IndexAdvisor::IndexAdvisor(ConnectionPool& pool) : pool_(pool) {
+}
+
+void IndexAdvisor::record(const std::string& table, const std::string& column) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++usage_[{ table, column }];
+}
+
+bool IndexAdvisor::columnExists(Connection& conn, const std::string& table, const std::string& column) {
+    auto query = conn.statements().get("SELECT 1 FROM pragma_table_info(?) WHERE name = ?");
+    query->bind(1, table);
+    query->bind(2, column);
+    return query->executeStep();
+}
+
+bool IndexAdvisor::hasLeadingIndex(Connection& conn, const std::string& table, const std::string& column) {
+    // The INTEGER PRIMARY KEY is the rowid and needs no index
+    if (column == "id") {
+        return true;
+    }
+    auto query = conn.statements().get(
+        "SELECT 1 FROM pragma_index_list(?) AS il, pragma_index_info(il.name) AS ii "
+        "WHERE ii.seqno = 0 AND ii.name = ?");
+    query->bind(1, table);
+    query->bind(2, column);
+    return query->executeStep();
+}
+
+std::vector<IndexSuggestion> IndexAdvisor::missingIndexes(size_t min_uses) {
+    std::map<std::pair<std::string, std::string>, size_t> usage;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        usage = usage_;
+    }
+    std::vector<IndexSuggestion> missing;
+    try {
+        auto conn = pool_.reader();
+        for (const auto& [key, uses] : usage) {
+            if (uses < min_uses) continue;
+            const auto& [table, column] = key;
+            if (!columnExists(*conn, table, column)) {
+                spdlog::debug("Index advisor skips unknown column {}.{}", table, column);
+                continue;
+            }
+            if (!hasLeadingIndex(*conn, table, column)) {
+                missing.push_back({ table, column, uses });
+            }
+        }
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Index advisor failed to inspect schema: {}", e.what());
+    }
+    return missing;
+}
+
+int IndexAdvisor::createMissingIndexes(size_t min_uses) {
+    int created = 0;
+    for (const auto& suggestion : missingIndexes(min_uses)) {
+        // Table and column names were checked against the schema above
+        std::string name = "idx_" + suggestion.table + "_" + suggestion.column;
+        try {
+            auto conn = pool_.writer();
+            conn->db().exec("CREATE INDEX IF NOT EXISTS " + name + " ON " + suggestion.table +
+                "(" + suggestion.column + ")");
+            spdlog::info("Created index {} ({} lookups)", name, suggestion.uses);
+            ++created;
+        }
+        catch (const SQLite::Exception& e) {
+            spdlog::error("Failed to create index {}: {}", name, e.what());
+        }
+    }
+    return created;
+}
+
+void IndexAdvisor::report(size_t min_uses) {
+    auto missing = missingIndexes(min_uses);
+    if (missing.empty()) {
+        spdlog::info("Index advisor: all searched columns are indexed");
+        return;
+    }
+    for (const auto& suggestion : missing) {
+        spdlog::warn("Index advisor: {}.{} used {} times without an index", suggestion.table,
+            suggestion.column, suggestion.uses);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include "connection_pool.h"
+
+struct IndexSuggestion {
+    std::string table;
+    std::string column;
+    size_t uses;
+};
+
+// Records which columns find/filter/del actually search and sort on, and
+// reports or creates single-column indexes for the ones that lack one
+class IndexAdvisor {
+private:
+    ConnectionPool& pool_;
+    std::mutex mutex_;
+    std::map<std::pair<std::string, std::string>, size_t> usage_;
+
+    bool columnExists(Connection& conn, const std::string& table, const std::string& column);
+    bool hasLeadingIndex(Connection& conn, const std::string& table, const std::string& column);
+
+public:
+    explicit IndexAdvisor(ConnectionPool& pool);
+    void record(const std::string& table, const std::string& column);
+    std::vector<IndexSuggestion> missingIndexes(size_t min_uses = 1);
+    int createMissingIndexes(size_t min_uses = 1);
+    void report(size_t min_uses = 1);
+};
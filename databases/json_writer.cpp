@@ -0,0 +1,115 @@
+#include "json_writer.h"
+
+JSONWriter::JSONWriter(const std::string& path, JSONStyle style, size_t buffer_size)
+    : out_(path, buffer_size), style_(style) {
+}
+
+std::optional<JSONStyle> JSONWriter::styleFor(const std::string& format_type) {
+    if (format_type == "json") return JSONStyle::Pretty;
+    if (format_type == "json-compact") return JSONStyle::Compact;
+    if (format_type == "ndjson") return JSONStyle::Lines;
+    return std::nullopt;
+}
+
+void JSONWriter::beginObject() {
+    if (style_ != JSONStyle::Lines) {
+        if (objects_ == 0) {
+            out_.append(style_ == JSONStyle::Pretty ? "[\n    {" : "[{");
+        }
+        else {
+            out_.append(style_ == JSONStyle::Pretty ? ",\n    {" : ",{");
+        }
+    }
+    else {
+        out_.append('{');
+    }
+    first_member_ = true;
+}
+
+void JSONWriter::key(std::string_view name) {
+    if (!first_member_) {
+        out_.append(',');
+    }
+    first_member_ = false;
+    if (style_ == JSONStyle::Pretty) {
+        out_.append("\n        ");
+    }
+    string(name);
+    out_.append(style_ == JSONStyle::Pretty ? ": " : ":");
+}
+
+void JSONWriter::value(std::string_view value) {
+    string(value);
+}
+
+void JSONWriter::value(long long value) {
+    out_.append(value);
+}
+
+void JSONWriter::value(const SQLite::Column& column) {
+    if (column.isNull()) {
+        out_.append("null");
+    }
+    else if (column.isInteger()) {
+        value(static_cast<long long>(column.getInt64()));
+    }
+    else {
+        value(std::string_view(column.getText(), column.getBytes()));
+    }
+}
+
+void JSONWriter::endObject() {
+    if (style_ == JSONStyle::Pretty) {
+        out_.append(first_member_ ? "}" : "\n    }");
+    }
+    else {
+        out_.append('}');
+    }
+    if (style_ == JSONStyle::Lines) {
+        out_.append('\n');
+    }
+    ++objects_;
+    out_.maybeFlush();
+}
+
+void JSONWriter::close() {
+    if (!closed_ && style_ != JSONStyle::Lines) {
+        if (objects_ == 0) {
+            out_.append("[]");
+        }
+        else {
+            out_.append(style_ == JSONStyle::Pretty ? "\n]" : "]");
+        }
+    }
+    closed_ = true;
+    out_.close();
+}
+
+void JSONWriter::string(std::string_view value) {
+    static const char hex[] = "0123456789abcdef";
+    out_.append('"');
+    size_t start = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out_.append(value.substr(start, i - start));
+        switch (c) {
+            case '"': out_.append("\\\""); break;
+            case '\\': out_.append("\\\\"); break;
+            case '\n': out_.append("\\n"); break;
+            case '\r': out_.append("\\r"); break;
+            case '\t': out_.append("\\t"); break;
+            case '\b': out_.append("\\b"); break;
+            case '\f': out_.append("\\f"); break;
+            default: {
+                char escaped[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+                out_.append(std::string_view(escaped, sizeof(escaped)));
+            }
+        }
+        start = i + 1;
+    }
+    out_.append(value.substr(start));
+    out_.append('"');
+}
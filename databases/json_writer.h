@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <optional>
+#include <SQLiteCpp/SQLiteCpp.h>
+#include "output_buffer.h"
+
+enum class JSONStyle {
+    Pretty,     // array of objects indented by 4 spaces, laid out as nlohmann::json::dump(4)
+    Compact,    // array of objects without whitespace
+    Lines       // NDJSON: one compact object per line
+};
+
+// Streaming JSON writer: each object is serialized into the output buffer
+// as soon as its row is read, without building a nlohmann::json DOM.
+// Keys are written in the order given; unlike nlohmann::json they are not sorted.
+class JSONWriter {
+private:
+    OutputBuffer out_;
+    JSONStyle style_;
+    size_t objects_ = 0;
+    bool first_member_ = true;
+    bool closed_ = false;
+
+    void string(std::string_view value);
+
+public:
+    JSONWriter(const std::string& path, JSONStyle style, size_t buffer_size = 1 << 20);
+
+    // Maps the export format names "json", "json-compact" and "ndjson"
+    static std::optional<JSONStyle> styleFor(const std::string& format_type);
+
+    bool isOpen() const { return out_.isOpen(); }
+    void beginObject();
+    void key(std::string_view name);
+    void value(std::string_view value);
+    void value(long long value);
+    void value(const SQLite::Column& column);
+    void endObject();
+    void close();
+    size_t objects() const { return objects_; }
+};
@@ -0,0 +1,53 @@
+#include "output_buffer.h"
+#include <charconv>
+#include <stdexcept>
+
+OutputBuffer::OutputBuffer(const std::string& path, size_t buffer_size)
+    : path_(path), capacity_(buffer_size > 0 ? buffer_size : 1) {
+    file_ = std::fopen(path.c_str(), "wb");
+    buffer_.reserve(capacity_ + 256);
+}
+
+OutputBuffer::~OutputBuffer() {
+    try {
+        close();
+    }
+    catch (...) {
+        // Errors are reported by an explicit close()
+    }
+}
+
+void OutputBuffer::append(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr);
+}
+
+void OutputBuffer::flush() {
+    if (file_ == nullptr || buffer_.empty()) {
+        return;
+    }
+    if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+        throw std::runtime_error("Failed to write file: " + path_);
+    }
+    buffer_.clear();
+}
+
+void OutputBuffer::close() {
+    if (file_ == nullptr) {
+        return;
+    }
+    try {
+        flush();
+    }
+    catch (...) {
+        std::fclose(file_);
+        file_ = nullptr;
+        throw;
+    }
+    int result = std::fclose(file_);
+    file_ = nullptr;
+    if (result != 0) {
+        throw std::runtime_error("Failed to close file: " + path_);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Append-only file output through one reusable in-memory buffer that is
+// written out with fwrite whenever it fills up
+class OutputBuffer {
+private:
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    std::string buffer_;
+    size_t capacity_;
+
+public:
+    explicit OutputBuffer(const std::string& path, size_t buffer_size = 1 << 20);
+    ~OutputBuffer();
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    bool isOpen() const { return file_ != nullptr; }
+    void append(std::string_view data) { buffer_.append(data); }
+    void append(char c) { buffer_.push_back(c); }
+    void append(long long value);
+    // Flushes only once the buffer is full; call after each logical record
+    void maybeFlush() {
+        if (buffer_.size() >= capacity_) flush();
+    }
+    void flush();
+    void close();
+};
@@ -0,0 +1,129 @@
+#include "query.h"
+
+namespace {
+    const char* comparison(Predicate::Op op) {
+        switch (op) {
+        case Predicate::Op::Equal: return " = ?";
+        case Predicate::Op::NotEqual: return " <> ?";
+        case Predicate::Op::Less: return " < ?";
+        case Predicate::Op::LessEqual: return " <= ?";
+        case Predicate::Op::Greater: return " > ?";
+        case Predicate::Op::GreaterEqual: return " >= ?";
+        default: return "";
+        }
+    }
+
+    // IN lists are padded to a power of two by repeating the last value, so
+    // lists of 5 to 8 values share one prepared statement
+    size_t paddedSize(size_t size) {
+        size_t padded = 1;
+        while (padded < size) {
+            padded *= 2;
+        }
+        return padded;
+    }
+}
+
+std::optional<Predicate::Op> comparisonOp(const std::string& op) {
+    if (op == "=") return Predicate::Op::Equal;
+    if (op == "<>" || op == "!=") return Predicate::Op::NotEqual;
+    if (op == "<") return Predicate::Op::Less;
+    if (op == "<=") return Predicate::Op::LessEqual;
+    if (op == ">") return Predicate::Op::Greater;
+    if (op == ">=") return Predicate::Op::GreaterEqual;
+    if (op == "between") return Predicate::Op::Between;
+    if (op == "in") return Predicate::Op::In;
+    return std::nullopt;
+}
+
+Predicate::Predicate(std::string column, Op op, std::vector<QueryValue> values)
+    : op_(op), column_(std::move(column)), values_(std::move(values)) {
+    const bool valid = op == Op::In
+        || (op == Op::Between && values_.size() == 2)
+        || (comparison(op)[0] != '\0' && values_.size() == 1);
+    if (!valid || column_.empty()) {
+        throw std::invalid_argument("Invalid condition on column '" + column_ + "'");
+    }
+}
+
+Predicate Predicate::combine(Op op, Predicate a, Predicate b) {
+    // Every row AND p is p, but every row OR p is still every row
+    if (a.matchesAll() || b.matchesAll()) {
+        if (op == Op::Or) {
+            return Predicate();
+        }
+        return a.matchesAll() ? std::move(b) : std::move(a);
+    }
+    // Chains of the same operator stay flat: a AND b AND c
+    Predicate result;
+    result.op_ = op;
+    for (Predicate* side : { &a, &b }) {
+        if (side->op_ == op) {
+            for (auto& child : side->children_) {
+                result.children_.push_back(std::move(child));
+            }
+        }
+        else {
+            result.children_.push_back(std::move(*side));
+        }
+    }
+    return result;
+}
+
+Predicate operator&&(Predicate a, Predicate b) {
+    return Predicate::combine(Predicate::Op::And, std::move(a), std::move(b));
+}
+
+Predicate operator||(Predicate a, Predicate b) {
+    return Predicate::combine(Predicate::Op::Or, std::move(a), std::move(b));
+}
+
+void Predicate::compile(std::string& sql, std::vector<QueryValue>& values) const {
+    switch (op_) {
+    case Op::All:
+        sql += "1";
+        break;
+    case Op::Between:
+        sql += column_ + " BETWEEN ? AND ?";
+        values.insert(values.end(), values_.begin(), values_.end());
+        break;
+    case Op::In:
+        if (values_.empty()) {
+            sql += "0";
+            break;
+        }
+        sql += column_ + " IN (?";
+        for (size_t i = 1; i < paddedSize(values_.size()); ++i) {
+            sql += ", ?";
+        }
+        sql += ")";
+        values.insert(values.end(), values_.begin(), values_.end());
+        values.insert(values.end(), paddedSize(values_.size()) - values_.size(), values_.back());
+        break;
+    case Op::And:
+    case Op::Or:
+        for (size_t i = 0; i < children_.size(); ++i) {
+            if (i > 0) {
+                sql += op_ == Op::And ? " AND " : " OR ";
+            }
+            const bool nested = children_[i].op_ == Op::And || children_[i].op_ == Op::Or;
+            if (nested) sql += "(";
+            children_[i].compile(sql, values);
+            if (nested) sql += ")";
+        }
+        break;
+    default:
+        sql += column_ + comparison(op_);
+        values.push_back(values_.front());
+        break;
+    }
+}
+
+void Predicate::columns(std::vector<std::string>& names) const {
+    if (!column_.empty()) {
+        names.push_back(column_);
+    }
+    for (const auto& child : children_) {
+        child.columns(names);
+    }
+}
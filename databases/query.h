@@ -0,0 +1,155 @@
+#pragma once
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "table_schema.h"
+
+// Value of a query parameter, bound with the type of its column so the
+// comparison can use the column's index
+using QueryValue = std::variant<long long, std::string>;
+
+// One node of a WHERE clause: a column compared with parameters, or an AND /
+// OR of other nodes. The default predicate matches every row.
+class Predicate {
+public:
+    enum class Op { All, Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, Between, In, And, Or };
+
+    Predicate() = default;
+    Predicate(std::string column, Op op, std::vector<QueryValue> values);
+
+    bool matchesAll() const { return op_ == Op::All; }
+    // Appends the condition to sql with ? placeholders, and its values in
+    // bind order to values
+    void compile(std::string& sql, std::vector<QueryValue>& values) const;
+    // Every column the condition refers to
+    void columns(std::vector<std::string>& names) const;
+
+    friend Predicate operator&&(Predicate a, Predicate b);
+    friend Predicate operator||(Predicate a, Predicate b);
+
+private:
+    Op op_ = Op::All;
+    std::string column_;
+    std::vector<QueryValue> values_;
+    std::vector<Predicate> children_;
+
+    static Predicate combine(Op op, Predicate a, Predicate b);
+};
+
+// Operator named by op: =, <>, !=, <, <=, >, >=, between or in
+std::optional<Predicate::Op> comparisonOp(const std::string& op);
+
+// Typed handle to a stored column, e.g. field(&Book::year) >= 1950.
+// Values must have the member's type, so a mistyped comparison does not compile.
+template <typename Model, typename Field>
+class FieldRef {
+private:
+    std::string name_;
+
+    static QueryValue value(const Field& field) {
+        if constexpr (std::is_same_v<Field, std::string>) {
+            return field;
+        }
+        else {
+            return static_cast<long long>(field);
+        }
+    }
+
+    Predicate compare(Predicate::Op op, const Field& field) const {
+        return Predicate(name_, op, { value(field) });
+    }
+
+public:
+    explicit FieldRef(std::string name) : name_(std::move(name)) {}
+    const std::string& name() const { return name_; }
+
+    Predicate operator==(const Field& field) const { return compare(Predicate::Op::Equal, field); }
+    Predicate operator!=(const Field& field) const { return compare(Predicate::Op::NotEqual, field); }
+    Predicate operator<(const Field& field) const { return compare(Predicate::Op::Less, field); }
+    Predicate operator<=(const Field& field) const { return compare(Predicate::Op::LessEqual, field); }
+    Predicate operator>(const Field& field) const { return compare(Predicate::Op::Greater, field); }
+    Predicate operator>=(const Field& field) const { return compare(Predicate::Op::GreaterEqual, field); }
+
+    // Inclusive on both ends, like SQL BETWEEN
+    Predicate between(const Field& low, const Field& high) const {
+        return Predicate(name_, Predicate::Op::Between, { value(low), value(high) });
+    }
+
+    Predicate in(const std::vector<Field>& fields) const {
+        std::vector<QueryValue> values;
+        values.reserve(fields.size());
+        for (const auto& field : fields) {
+            values.push_back(value(field));
+        }
+        return Predicate(name_, Predicate::Op::In, std::move(values));
+    }
+};
+
+// Column of Model stored in member; throws std::invalid_argument for a
+// member that is not mapped in Schema<Model>
+template <typename Model, typename Field>
+FieldRef<Model, Field> field(Field Model::* member) {
+    const char* name = nullptr;
+    forEachColumn<Model>([&](const auto& column) {
+        if constexpr (std::is_same_v<typename std::decay_t<decltype(column)>::field_type, Field>) {
+            if (column.member == member) {
+                name = column.name;
+            }
+        }
+    });
+    if (name == nullptr) {
+        throw std::invalid_argument(std::string("Member is not a stored column of ") + Schema<Model>::table);
+    }
+    return FieldRef<Model, Field>(name);
+}
+
+struct SortKey {
+    std::string column;
+    bool descending = false;
+};
+
+// Rows selected by Repository<Model>::select/forEach/show, built as
+//   Query<Book>().where(field(&Book::author_id) == 7 && field(&Book::year).between(1950, 1990))
+//       .orderBy(&Book::year).limit(20)
+// It compiles to one parameterized statement; queries of the same shape
+// share the prepared statement whatever their values.
+template <typename Model>
+class Query {
+private:
+    Predicate condition_;
+    std::vector<SortKey> order_;
+    size_t limit_ = 0;
+
+public:
+    // Repeated calls are combined with AND
+    Query& where(Predicate predicate) {
+        condition_ = std::move(condition_) && std::move(predicate);
+        return *this;
+    }
+
+    // Keys are applied in the order they were added
+    template <typename Field>
+    Query& orderBy(Field Model::* member, bool descending = false) {
+        order_.push_back(SortKey{ field(member).name(), descending });
+        return *this;
+    }
+
+    // By column name, for columns chosen at run time; checked when the query runs
+    Query& orderBy(const std::string& column, bool descending = false) {
+        order_.push_back(SortKey{ column, descending });
+        return *this;
+    }
+
+    // At most rows rows, 0 for all
+    Query& limit(size_t rows) {
+        limit_ = rows;
+        return *this;
+    }
+
+    const Predicate& condition() const { return condition_; }
+    const std::vector<SortKey>& order() const { return order_; }
+    size_t rowLimit() const { return limit_; }
+};
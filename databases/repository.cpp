@@ -0,0 +1,1253 @@
+#include "repository.h"
+#include <spdlog/spdlog.h>
+#include <sqlite3.h>
+#include <algorithm>
+#include <charconv>
+#include <optional>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+#include <variant>
+#include "csv_writer.h"
+#include "json_writer.h"
+#include "fuzzy_match.h"
+
+namespace {
+    // External-content FTS5 index over some columns of a table and the
+    // triggers that keep it in sync; empty if no column is indexed
+    struct TextIndexSQL {
+        std::string table;
+        std::string create;
+        std::vector<std::string> triggers;
+    };
+
+    // SQL of one table, generated from its column list on first use
+    struct TableSQL {
+        std::string select;         // all mapped columns
+        std::string insert;
+        std::string exists;         // dedup key columns as parameters
+        std::string keys;           // dedup key columns of every row
+        std::string exported;       // columns that are printed and exported
+        std::string export_header;
+        std::vector<const char*> export_keys;
+        std::vector<size_t> json_order;     // exported columns by key, as nlohmann::json sorted them
+        TextIndexSQL text;          // FullText columns, word tokens
+        std::string text_search;
+        TextIndexSQL trigram;       // Trigram column, every 3 characters
+        std::string name_prefix;    // trigram rows starting with ?, in name order
+        std::string name_like;      // prefixes too short to have a trigram
+        std::string name_similar;   // trigram rows sharing most trigrams with ?
+        std::vector<const char*> derived;
+        std::string select_row;     // one row by id
+        std::string update_derived; // Derived columns of one row by id
+    };
+
+    std::string join(const std::vector<std::string>& parts, const char* separator) {
+        std::string result;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (i > 0) result += separator;
+            result += parts[i];
+        }
+        return result;
+    }
+
+    TextIndexSQL textIndexSQL(const std::string& table, const std::string& index,
+        const std::vector<std::string>& columns, const char* tokenizer) {
+        TextIndexSQL sql;
+        if (columns.empty()) {
+            return sql;
+        }
+        std::vector<std::string> new_values, old_values;
+        for (const auto& column : columns) {
+            new_values.push_back("new." + column);
+            old_values.push_back("old." + column);
+        }
+        const std::string list = join(columns, ", ");
+        const std::string insert_new = "INSERT INTO " + index + "(rowid, " + list + ") VALUES (new.id, " + join(new_values, ", ") + "); ";
+        const std::string delete_old = "INSERT INTO " + index + "(" + index + ", rowid, " + list + ") VALUES ('delete', old.id, " + join(old_values, ", ") + "); ";
+        sql.table = index;
+        sql.create = "CREATE VIRTUAL TABLE IF NOT EXISTS " + index + " USING fts5(" + list +
+            ", content='" + table + "', content_rowid='id', tokenize='" + tokenizer + "')";
+        sql.triggers = {
+            "CREATE TRIGGER IF NOT EXISTS " + index + "_insert AFTER INSERT ON " + table + " BEGIN " + insert_new + "END",
+            "CREATE TRIGGER IF NOT EXISTS " + index + "_delete AFTER DELETE ON " + table + " BEGIN " + delete_old + "END",
+            // Updates of other columns leave the index alone
+            "CREATE TRIGGER IF NOT EXISTS " + index + "_update AFTER UPDATE OF " + list + " ON " + table +
+                " BEGIN " + delete_old + insert_new + "END"
+        };
+        return sql;
+    }
+
+    template <typename Model>
+    TableSQL buildSQL() {
+        const std::string table = Schema<Model>::table;
+        std::vector<std::string> all, qualified, inserted, placeholders, keys, key_conditions, exported, headers;
+        std::vector<std::string> text, names, derived;
+        TableSQL sql;
+        forEachColumn<Model>([&](const auto& column) {
+            all.push_back(column.name);
+            qualified.push_back("t." + std::string(column.name));
+            if (column.has(column_flags::FullText)) {
+                text.push_back(column.name);
+            }
+            if (column.has(column_flags::Trigram)) {
+                names.push_back(column.name);
+            }
+            if (column.has(column_flags::Derived)) {
+                sql.derived.push_back(column.name);
+                derived.push_back(std::string(column.name) + " = ?");
+            }
+            if (!column.has(column_flags::PrimaryKey)) {
+                inserted.push_back(column.name);
+                placeholders.push_back("?");
+            }
+            if (column.has(column_flags::DedupKey)) {
+                keys.push_back(column.name);
+                key_conditions.push_back(std::string(column.name) + " = ?");
+            }
+            if (!column.has(column_flags::Hidden)) {
+                exported.push_back(column.name);
+                headers.push_back(column.export_key);
+                sql.export_keys.push_back(column.export_key);
+            }
+        });
+        sql.select = "SELECT " + join(all, ", ") + " FROM " + table;
+        sql.insert = "INSERT INTO " + table + " (" + join(inserted, ", ") + ") VALUES (" + join(placeholders, ", ") + ")";
+        sql.exists = "SELECT 1 FROM " + table + " WHERE " + join(key_conditions, " AND ");
+        sql.keys = "SELECT " + join(keys, ", ") + " FROM " + table;
+        sql.exported = "SELECT " + join(exported, ", ") + " FROM " + table;
+        sql.export_header = join(headers, ",") + "\n";
+        // JSON exports keep the key order of the earlier nlohmann::json objects
+        sql.json_order.resize(sql.export_keys.size());
+        for (size_t i = 0; i < sql.json_order.size(); ++i) {
+            sql.json_order[i] = i;
+        }
+        std::sort(sql.json_order.begin(), sql.json_order.end(), [&](size_t a, size_t b) {
+            return std::strcmp(sql.export_keys[a], sql.export_keys[b]) < 0;
+        });
+        sql.select_row = sql.select + " WHERE id = ?";
+        if (!derived.empty()) {
+            sql.update_derived = "UPDATE " + table + " SET " + join(derived, ", ") + " WHERE id = ?";
+        }
+        sql.text = textIndexSQL(table, table + "_fts", text, "unicode61 remove_diacritics 2");
+        if (!text.empty()) {
+            const std::string& fts = sql.text.table;
+            // rank is bm25() and lets FTS5 sort without computing it twice
+            sql.text_search = "SELECT " + join(qualified, ", ") + ", -" + fts + ".rank, snippet(" + fts +
+                ", -1, '[', ']', '...', 12) FROM " + fts + " JOIN " + table + " t ON t.id = " + fts +
+                ".rowid WHERE " + fts + " MATCH ? ORDER BY " + fts + ".rank LIMIT ?";
+        }
+        sql.trigram = textIndexSQL(table, table + "_trigram", names, "trigram");
+        if (!names.empty()) {
+            const std::string& trg = sql.trigram.table;
+            const std::string name = "t." + names.front();
+            const std::string matched = "SELECT " + join(qualified, ", ") + " FROM " + trg + " JOIN " + table +
+                " t ON t.id = " + trg + ".rowid WHERE " + trg + " MATCH ?";
+            sql.name_prefix = matched + " ORDER BY " + name + ", t.id LIMIT ?";
+            sql.name_similar = matched + " ORDER BY " + trg + ".rank LIMIT ?";
+            // Walks the name index in order and stops after LIMIT matches
+            sql.name_like = "SELECT " + join(qualified, ", ") + " FROM " + table + " t WHERE " + name +
+                " LIKE ? ESCAPE '\\' ORDER BY " + name + ", t.id LIMIT ?";
+        }
+        return sql;
+    }
+
+    template <typename Model>
+    const TableSQL& tableSQL() {
+        static const TableSQL sql = buildSQL<Model>();
+        return sql;
+    }
+
+    void readField(const SQLite::Column& column, int& field) {
+        field = column.getInt();
+    }
+
+    void readField(const SQLite::Column& column, std::string& field) {
+        field.assign(column.getText(), column.getBytes());
+    }
+
+    void hashField(KeyHash& hash, int field) {
+        hash.add(static_cast<long long>(field));
+    }
+
+    void hashField(KeyHash& hash, const std::string& field) {
+        hash.add(std::string_view(field));
+    }
+
+    // Key columns of the dedup check, in the order of the exists query
+    template <typename Model>
+    uint64_t modelKey(const Model& model) {
+        KeyHash hash;
+        forEachColumn<Model>([&](const auto& column) {
+            if (column.has(column_flags::DedupKey)) {
+                hashField(hash, model.*column.member);
+            }
+        });
+        return hash.value();
+    }
+
+    // Same key computed from a row of the keys query
+    template <typename Model>
+    uint64_t rowKey(SQLite::Statement& query) {
+        KeyHash hash;
+        int index = 0;
+        forEachColumn<Model>([&](const auto& column) {
+            using Field = typename std::decay_t<decltype(column)>::field_type;
+            if (!column.has(column_flags::DedupKey)) {
+                return;
+            }
+            SQLite::Column value = query.getColumn(index++);
+            if constexpr (std::is_same_v<Field, std::string>) {
+                hash.add(std::string_view(value.getText(), value.getBytes()));
+            }
+            else {
+                hash.add(static_cast<long long>(value.getInt64()));
+            }
+        });
+        return hash.value();
+    }
+
+    // Binds the columns selected by flag test starting at parameter 1 and
+    // returns the next parameter
+    template <typename Model, typename Test>
+    int bindColumns(SQLite::Statement& query, const Model& model, Test test) {
+        int index = 1;
+        forEachColumn<Model>([&](const auto& column) {
+            if (test(column)) {
+                query.bind(index++, model.*column.member);
+            }
+        });
+        return index;
+    }
+
+    template <typename Model>
+    void bindKey(SQLite::Statement& query, const Model& model) {
+        bindColumns(query, model, [](const auto& column) { return column.has(column_flags::DedupKey); });
+    }
+
+    template <typename Model>
+    void bindInsert(SQLite::Statement& query, const Model& model) {
+        bindColumns(query, model, [](const auto& column) { return !column.has(column_flags::PrimaryKey); });
+    }
+
+    // Recomputes derived members from the text they follow; called only where that text is written,
+    // reads trust the stored columns
+    template <typename Model>
+    void derive(Model& model) {
+        if constexpr (requires { Schema<Model>::derive(model); }) {
+            Schema<Model>::derive(model);
+        }
+    }
+
+    template <typename Model>
+    void bindDerived(SQLite::Statement& query, const Model& model) {
+        const int next = bindColumns(query, model, [](const auto& column) { return column.has(column_flags::Derived); });
+        query.bind(next, model.id);
+    }
+
+    bool hasStoredColumn(Connection& conn, const char* table, const char* column) {
+        auto query = conn.statements().get("SELECT 1 FROM pragma_table_info(?) WHERE name = ?");
+        query->bind(1, table);
+        query->bind(2, column);
+        return query->executeStep();
+    }
+
+    std::string cellText(int field) {
+        return std::to_string(field);
+    }
+
+    const std::string& cellText(const std::string& field) {
+        return field;
+    }
+
+    void appendCell(std::string& out, const std::string& value, size_t width) {
+        out.append(value, 0, width);
+        out.append(width - std::min(width, value.size()), ' ');
+    }
+
+    // User text as an FTS5 query: every word must match, "word*" matches a
+    // prefix. Words are quoted so punctuation is never parsed as syntax.
+    std::string matchExpression(const std::string& terms) {
+        std::string expression;
+        std::istringstream words(terms);
+        std::string word;
+        while (words >> word) {
+            const bool prefix = word.size() > 1 && word.back() == '*';
+            if (prefix) {
+                word.pop_back();
+            }
+            if (!expression.empty()) {
+                expression += ' ';
+            }
+            expression += '"';
+            for (char c : word) {
+                if (c == '"') expression += '"';
+                expression += c;
+            }
+            expression += '"';
+            if (prefix) {
+                expression += '*';
+            }
+        }
+        return expression;
+    }
+
+    // Value of the Trigram column
+    template <typename Model>
+    std::string_view nameOf(const Model& model) {
+        std::string_view name;
+        forEachColumn<Model>([&](const auto& column) {
+            using Field = typename std::decay_t<decltype(column)>::field_type;
+            if constexpr (std::is_same_v<Field, std::string>) {
+                if (name.empty() && column.has(column_flags::Trigram)) {
+                    name = model.*column.member;
+                }
+            }
+        });
+        return name;
+    }
+
+    std::string_view trimName(std::string_view text) {
+        const size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string_view::npos) {
+            return {};
+        }
+        return text.substr(begin, text.find_last_not_of(" \t\r\n") - begin + 1);
+    }
+
+    // LIKE pattern matching text literally at the start
+    std::string likePrefix(std::string_view text) {
+        std::string pattern;
+        for (char c : text) {
+            if (c == '%' || c == '_' || c == '\\') pattern += '\\';
+            pattern += c;
+        }
+        pattern += '%';
+        return pattern;
+    }
+
+    bool parseInteger(std::string_view text, long long& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    template <typename Model>
+    bool isIntegerColumn(const std::string& name) {
+        bool integer = false;
+        forEachColumn<Model>([&](const auto& column) {
+            using Field = typename std::decay_t<decltype(column)>::field_type;
+            if (name == column.name) {
+                integer = std::is_same_v<Field, int>;
+            }
+        });
+        return integer;
+    }
+
+    template <typename Model>
+    bool isDerivedColumn(const std::string& name) {
+        bool derived = false;
+        forEachColumn<Model>([&](const auto& column) {
+            derived = derived || (name == column.name && column.has(column_flags::Derived));
+        });
+        return derived;
+    }
+
+    // User text as a parameter of the column's type; a number compared with an
+    // INTEGER column as text would not use its index. False if it is not a number.
+    template <typename Model>
+    bool columnValue(const std::string& name, const std::string& text, QueryValue& value) {
+        if (!isIntegerColumn<Model>(name)) {
+            value = text;
+            return true;
+        }
+        long long number = 0;
+        if (!parseInteger(text, number)) {
+            return false;
+        }
+        value = number;
+        return true;
+    }
+
+    // Last row of a page: its id and, when sorted by a column, that column's
+    // value or whether it is NULL
+    struct PagePosition {
+        long long id = 0;
+        std::string text;
+        long long number = 0;
+        bool null = false;
+    };
+
+    // Tokens are "<id>", "<id>:<sort value>", or "<id>!" when the sort value
+    // is NULL; a model holds NULL as "" or 0, so the caller says which it is
+    template <typename Model>
+    std::string pageToken(const Model& model, const std::string& order_by, bool null) {
+        std::string token = std::to_string(model.id);
+        if (null) {
+            return token + '!';
+        }
+        forEachColumn<Model>([&](const auto& column) {
+            if (order_by == column.name) {
+                token += ':';
+                token += cellText(model.*column.member);
+            }
+        });
+        return token;
+    }
+
+    template <typename Model>
+    bool parseToken(const std::string& token, const std::string& order_by, PagePosition& position) {
+        const size_t colon = token.find(':');
+        if (!order_by.empty() && colon == std::string::npos && !token.empty() && token.back() == '!') {
+            position.null = true;
+            return parseInteger(std::string_view(token).substr(0, token.size() - 1), position.id);
+        }
+        if (order_by.empty() != (colon == std::string::npos)) {
+            return false;
+        }
+        if (!parseInteger(std::string_view(token).substr(0, colon), position.id)) {
+            return false;
+        }
+        if (order_by.empty()) {
+            return true;
+        }
+        position.text = token.substr(colon + 1);
+        return !isIntegerColumn<Model>(order_by) || parseInteger(position.text, position.number);
+    }
+}
+
+template <typename Model>
+Repository<Model>::Repository(ConnectionPool& pool, IndexAdvisor& advisor)
+    : pool_(pool), advisor_(advisor) {
+    spdlog::info("{}Repository initialized with database: {}", Table::entity, pool_.path());
+    initialize();
+}
+
+template <typename Model>
+bool Repository<Model>::initialize() {
+    try {
+        auto conn = pool_.writer();
+        conn->db().exec(Table::create_sql);
+        addDerivedColumns(*conn);
+        for (const char* index : Table::indexes) {
+            conn->db().exec(index);
+        }
+        spdlog::info("{} table initialized", Table::entity);
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to initialize {} table: {}", Table::table, e.what());
+        return false;
+    }
+    initializeTextIndexes();
+    return true;
+}
+
+template <typename Model>
+void Repository<Model>::addDerivedColumns(Connection& conn) {
+    const TableSQL& sql = tableSQL<Model>();
+    std::vector<std::string> missing;
+    for (const char* column : sql.derived) {
+        if (!hasStoredColumn(conn, Table::table, column)) {
+            missing.push_back(column);
+        }
+    }
+    if (missing.empty()) {
+        return;
+    }
+    // Tables created before the columns existed get them and are filled once
+    SQLite::Transaction transaction(conn.db());
+    for (const auto& column : missing) {
+        conn.db().exec(std::string("ALTER TABLE ") + Table::table + " ADD COLUMN " + column + " INTEGER NOT NULL DEFAULT 0");
+    }
+    auto rows = conn.statements().get(sql.select);
+    auto update = conn.statements().get(sql.update_derived);
+    Model model(trusted_row);
+    size_t filled = 0;
+    while (rows->executeStep()) {
+        readRow(*rows, model);
+        derive(model);
+        update->reset();
+        bindDerived(*update, model);
+        update->exec();
+        ++filled;
+    }
+    transaction.commit();
+    spdlog::info("Added {} to {} and filled {} rows", join(missing, ", "), Table::table, filled);
+}
+
+template <typename Model>
+bool Repository<Model>::initializeTextIndexes() {
+    const TableSQL& sql = tableSQL<Model>();
+    bool ready = true;
+    for (const TextIndexSQL* index : { &sql.text, &sql.trigram }) {
+        if (index->create.empty()) {
+            continue;
+        }
+        try {
+            auto conn = pool_.writer();
+            const bool created = !conn->db().tableExists(index->table);
+            SQLite::Transaction transaction(conn->db());
+            conn->db().exec(index->create);
+            for (const auto& trigger : index->triggers) {
+                conn->db().exec(trigger);
+            }
+            // Rows stored before the index existed are indexed once
+            if (created) {
+                conn->db().exec("INSERT INTO " + index->table + "(" + index->table + ") VALUES ('rebuild')");
+            }
+            transaction.commit();
+            spdlog::info("{} index {} ready{}", Table::entity, index->table, created ? " (rebuilt)" : "");
+        }
+        catch (const SQLite::Exception& e) {
+            // The table still works without it, only the searches using it are unavailable
+            spdlog::warn("{} index {} unavailable: {}", Table::entity, index->table, e.what());
+            ready = false;
+        }
+    }
+    return ready;
+}
+
+template <typename Model>
+void Repository<Model>::readRow(SQLite::Statement& query, Model& model) {
+    // Strings are assigned in place, so a reused model keeps its capacity
+    int index = 0;
+    forEachColumn<Model>([&](const auto& column) {
+        readField(query.getColumn(index++), model.*column.member);
+    });
+}
+
+template <typename Model>
+size_t Repository<Model>::visitRows(const std::string& sql, const std::vector<QueryValue>& values,
+    const RowVisitor<Model>& visit) {
+    size_t visited = 0;
+    try {
+        auto conn = pool_.reader();
+        auto statement = conn->statements().get(sql);
+        int parameter = 1;
+        for (const auto& value : values) {
+            std::visit([&](const auto& typed) { statement->bind(parameter++, typed); }, value);
+        }
+        // Stored rows were validated on save, so they skip the model's checks
+        Model model(trusted_row);
+        while (statement->executeStep()) {
+            readRow(*statement, model);
+            ++visited;
+            if (!visit(model)) {
+                break;
+            }
+        }
+        return visited;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to read {} after {} rows: {}", Table::plural, visited, e.what());
+        return 0;
+    }
+}
+
+template <typename Model>
+size_t Repository<Model>::forEach(const RowQuery& query, const RowVisitor<Model>& visit) {
+    if (!query.field.empty() && !hasColumn<Model>(query.field)) {
+        spdlog::error("Unknown {} column '{}'", Table::table, query.field);
+        return 0;
+    }
+    if (!query.order_by.empty() && !hasColumn<Model>(query.order_by)) {
+        spdlog::error("Unknown {} column '{}'", Table::table, query.order_by);
+        return 0;
+    }
+    PagePosition after;
+    if (!query.after.empty() && !parseToken<Model>(query.after, query.order_by, after)) {
+        spdlog::error("Invalid {} page token '{}'", Table::table, query.after);
+        return 0;
+    }
+    // Rows are always ordered by (order_by, id), so a page boundary is
+    // one row-value comparison that an index on order_by can seek to.
+    // SQLite sorts NULL before every value, and the comparison is never true
+    // for NULL, so rows with a NULL key are matched with IS NULL instead.
+    const char* direction = query.descending ? " DESC" : " ASC";
+    const char* seek = query.descending ? " < " : " > ";
+    std::string sql = tableSQL<Model>().select;
+    std::string order = " ORDER BY id" + std::string(direction);
+    std::vector<std::string> conditions;
+    std::vector<QueryValue> values;
+    if (!query.field.empty()) {
+        QueryValue value;
+        if (!columnValue<Model>(query.field, query.value, value)) {
+            spdlog::error("Invalid {} {} '{}', expected a number", Table::table, query.field, query.value);
+            return 0;
+        }
+        advisor_.record(Table::table, query.field);
+        conditions.push_back(query.field + " = ?");
+        values.push_back(std::move(value));
+    }
+    if (!query.order_by.empty()) {
+        advisor_.record(Table::table, query.order_by);
+        order = " ORDER BY " + query.order_by + direction + ", id" + direction;
+    }
+    if (!query.after.empty()) {
+        if (query.order_by.empty()) {
+            conditions.push_back("id" + std::string(seek) + "?");
+        }
+        else if (after.null) {
+            // Ascending, the rest of the NULL rows and then every value;
+            // descending, NULL rows come last
+            conditions.push_back(query.descending
+                ? query.order_by + " IS NULL AND id < ?"
+                : "((" + query.order_by + " IS NULL AND id > ?) OR " + query.order_by + " IS NOT NULL)");
+        }
+        else {
+            const std::string comparison = "(" + query.order_by + ", id)" + seek + "(?, ?)";
+            conditions.push_back(query.descending
+                ? "(" + comparison + " OR " + query.order_by + " IS NULL)"
+                : comparison);
+            // Typed like the column, so the comparison uses its index
+            if (isIntegerColumn<Model>(query.order_by)) {
+                values.push_back(after.number);
+            }
+            else {
+                values.push_back(after.text);
+            }
+        }
+        values.push_back(after.id);
+    }
+    if (!conditions.empty()) {
+        sql += " WHERE " + join(conditions, " AND ");
+    }
+    sql += order;
+    if (query.limit > 0) {
+        sql += " LIMIT ?";
+        values.push_back(static_cast<long long>(query.limit));
+    }
+    return visitRows(sql, values, visit);
+}
+
+template <typename Model>
+size_t Repository<Model>::forEach(const Query<Model>& query, const RowVisitor<Model>& visit) {
+    std::vector<std::string> columns;
+    query.condition().columns(columns);
+    for (const auto& key : query.order()) {
+        columns.push_back(key.column);
+    }
+    for (const auto& column : columns) {
+        if (!hasColumn<Model>(column)) {
+            spdlog::error("Unknown {} column '{}'", Table::table, column);
+            return 0;
+        }
+        advisor_.record(Table::table, column);
+    }
+    // Values only ever become parameters, so the SQL depends on the shape of
+    // the query alone and the statement cache reuses it
+    std::string sql = tableSQL<Model>().select;
+    std::vector<QueryValue> values;
+    if (!query.condition().matchesAll()) {
+        sql += " WHERE ";
+        query.condition().compile(sql, values);
+    }
+    std::vector<std::string> order;
+    for (const auto& key : query.order()) {
+        order.push_back(key.column + (key.descending ? " DESC" : " ASC"));
+    }
+    if (!order.empty()) {
+        sql += " ORDER BY " + join(order, ", ");
+    }
+    if (query.rowLimit() > 0) {
+        sql += " LIMIT ?";
+        values.push_back(static_cast<long long>(query.rowLimit()));
+    }
+    return visitRows(sql, values, visit);
+}
+
+template <typename Model>
+std::vector<Model> Repository<Model>::collect(const RowQuery& query) {
+    std::vector<Model> models;
+    forEach(query, [&](Model& model) {
+        models.push_back(std::move(model));
+        return true;
+    });
+    return models;
+}
+
+template <typename Model>
+std::vector<Model> Repository<Model>::select(const Query<Model>& query) {
+    std::vector<Model> models;
+    forEach(query, [&](Model& model) {
+        models.push_back(std::move(model));
+        return true;
+    });
+    return models;
+}
+
+template <typename Model>
+int Repository<Model>::show(const Query<Model>& query) {
+    std::vector<Model> models = select(query);
+    spdlog::info("Query returned {} {}", models.size(), Table::plural);
+    printTable(models);
+    return static_cast<int>(models.size());
+}
+
+template <typename Model>
+bool Repository<Model>::exists(Connection& conn, const Model& model) {
+    // During an import a miss in the dedup index proves the row is new
+    if (!dedup_.mayContain(modelKey(model))) {
+        return false;
+    }
+    auto query = conn.statements().get(tableSQL<Model>().exists);
+    bindKey(*query, model);
+    return query->executeStep();
+}
+
+template <typename Model>
+bool Repository<Model>::exists(const Model& model) {
+    try {
+        auto conn = pool_.writer();
+        bool exists = this->exists(*conn, model);
+        spdlog::debug("Checked existence of {} '{}': {}", Table::table, model.*Table::label,
+            exists ? "exists" : "does not exist");
+        return exists;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to check {} existence: {}", Table::table, e.what());
+        return false;
+    }
+}
+
+template <typename Model>
+bool Repository<Model>::beginImport() {
+    auto conn = pool_.writer();
+    try {
+        auto count = conn->db().execAndGet(std::string("SELECT COUNT(*) FROM ") + Table::table).getInt64();
+        dedup_.reset(static_cast<size_t>(count));
+        auto query = conn->statements().get(tableSQL<Model>().keys);
+        while (query->executeStep()) {
+            dedup_.insert(rowKey<Model>(*query));
+        }
+        spdlog::info("Loaded {} {} keys into the import dedup index", dedup_.size(), Table::table);
+        return true;
+    }
+    catch (const SQLite::Exception& e) {
+        dedup_.unload();
+        spdlog::error("Failed to load {} dedup index, using database checks: {}", Table::table, e.what());
+        return false;
+    }
+}
+
+template <typename Model>
+void Repository<Model>::endImport() {
+    auto conn = pool_.writer();
+    if (!dedup_.loaded()) {
+        return;
+    }
+    spdlog::info("{} dedup index: {} keys, {} lookups, {} confirmed in database",
+        Table::entity, dedup_.size(), dedup_.checks(), dedup_.fallbacks());
+    dedup_.unload();
+}
+
+template <typename Model>
+int Repository<Model>::save(Model& model) {
+    try {
+        // The check and the insert share one lease, no other writer can slip in between
+        auto conn = pool_.writer();
+        if (exists(*conn, model)) {
+            spdlog::warn("{} '{}' already exists", Table::entity, model.*Table::label);
+            return -1;
+        }
+        derive(model);
+        auto query = conn->statements().get(tableSQL<Model>().insert);
+        bindInsert(*query, model);
+        query->exec();
+        int last_id = static_cast<int>(conn->db().getLastInsertRowid());
+        dedup_.insert(modelKey(model));
+        model.id = last_id;
+        spdlog::info("Saved {} '{}', ID: {}", Table::table, model.*Table::label, last_id);
+        return last_id;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to save {} '{}': {}", Table::table, model.*Table::label, e.what());
+        return -1;
+    }
+}
+
+template <typename Model>
+int Repository<Model>::saveBatch(std::vector<Model>& models, const BatchCommitHook& before_commit) {
+    int inserted = 0;
+    try {
+        auto conn = pool_.writer();
+        // One transaction per batch, statements are reused from the cache
+        SQLite::Transaction transaction(conn->db());
+        auto exists_query = conn->statements().get(tableSQL<Model>().exists);
+        auto insert_query = conn->statements().get(tableSQL<Model>().insert);
+        for (auto& model : models) {
+            model.id = -1;
+            try {
+                const uint64_t key = modelKey(model);
+                if (dedup_.mayContain(key)) {
+                    exists_query->reset();
+                    bindKey(*exists_query, model);
+                    if (exists_query->executeStep()) {
+                        spdlog::debug("{} '{}' already exists", Table::entity, model.*Table::label);
+                        continue;
+                    }
+                }
+                derive(model);
+                insert_query->reset();
+                bindInsert(*insert_query, model);
+                insert_query->exec();
+                model.id = static_cast<int>(conn->db().getLastInsertRowid());
+                dedup_.insert(key);
+                ++inserted;
+            }
+            catch (const SQLite::Exception& e) {
+                // Only a rejected row is skipped; other errors may have made SQLite roll back
+                // the transaction already, so the whole batch fails
+                if ((e.getErrorCode() & 0xff) != SQLITE_CONSTRAINT) {
+                    throw;
+                }
+                spdlog::warn("Failed to save {} '{}' in batch: {}", Table::table, model.*Table::label, e.what());
+            }
+        }
+        exists_query->reset();
+        if (before_commit) {
+            before_commit(*conn);
+        }
+        transaction.commit();
+        spdlog::info("Saved batch of {} {}, {} inserted", models.size(), Table::plural, inserted);
+        return inserted;
+    }
+    catch (const SQLite::Exception& e) {
+        // The transaction was rolled back, nothing from this batch is stored
+        for (auto& model : models) {
+            model.id = -1;
+        }
+        spdlog::error("Failed to save batch of {}: {}", Table::plural, e.what());
+        return -1;
+    }
+}
+
+template <typename Model>
+void Repository<Model>::printTable(const std::vector<Model>& models) {
+    if (models.empty()) {
+        std::cout << "No " << Table::plural << " found.\n";
+        spdlog::info("No {} found for display", Table::plural);
+        return;
+    }
+
+    // Column widths: initial width, header and the longest value
+    std::vector<size_t> widths;
+    forEachColumn<Model>([&](const auto& column) {
+        if (column.has(column_flags::Hidden)) {
+            return;
+        }
+        size_t width = std::max<size_t>(column.width, std::strlen(column.heading));
+        for (const auto& model : models) {
+            width = std::max(width, cellText(model.*column.member).size());
+        }
+        widths.push_back(width);
+    });
+
+    size_t line_width = 3 * (widths.size() - 1);
+    for (size_t width : widths) {
+        line_width += width;
+    }
+
+    // The whole table is formatted into one buffer and written at once
+    std::string out;
+    out.reserve((line_width + 1) * (models.size() + 4));
+    out += "\n";
+    out.append(line_width, '=');
+    out += "\n";
+    size_t i = 0;
+    forEachColumn<Model>([&](const auto& column) {
+        if (column.has(column_flags::Hidden)) {
+            return;
+        }
+        if (i > 0) out += " | ";
+        appendCell(out, column.heading, widths[i++]);
+    });
+    out += "\n";
+    out.append(line_width, '-');
+    out += "\n";
+    for (const auto& model : models) {
+        i = 0;
+        forEachColumn<Model>([&](const auto& column) {
+            if (column.has(column_flags::Hidden)) {
+                return;
+            }
+            if (i > 0) out += " | ";
+            appendCell(out, cellText(model.*column.member), widths[i++]);
+        });
+        out += "\n";
+    }
+    out.append(line_width, '=');
+    out += "\n\n";
+    std::cout << out;
+}
+
+template <typename Model>
+void Repository<Model>::showAll() {
+    std::vector<Model> models = collect(RowQuery{});
+    spdlog::info("Retrieved {} {} for showAll", models.size(), Table::plural);
+    printTable(models);
+}
+
+template <typename Model>
+std::vector<SearchHit<Model>> Repository<Model>::searchText(const std::string& terms, size_t limit) {
+    std::vector<SearchHit<Model>> hits;
+    const TableSQL& sql = tableSQL<Model>();
+    const std::string expression = matchExpression(terms);
+    if (sql.text_search.empty() || expression.empty()) {
+        return hits;
+    }
+    try {
+        auto conn = pool_.reader();
+        auto query = conn->statements().get(sql.text_search);
+        query->bind(1, expression);
+        query->bind(2, static_cast<long long>(limit));
+        const int score_column = static_cast<int>(std::tuple_size_v<decltype(Table::columns)>);
+        Model model(trusted_row);
+        while (query->executeStep()) {
+            readRow(*query, model);
+            hits.push_back(SearchHit<Model>{ std::move(model), query->getColumn(score_column).getDouble(),
+                query->getColumn(score_column + 1).getString() });
+        }
+        spdlog::info("Full-text search for '{}' found {} {}", terms, hits.size(), Table::plural);
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to search {} for '{}': {}", Table::plural, terms, e.what());
+    }
+    return hits;
+}
+
+template <typename Model>
+int Repository<Model>::showSearch(const std::string& terms, size_t limit) {
+    std::vector<SearchHit<Model>> hits = searchText(terms, limit);
+    std::string out;
+    for (size_t i = 0; i < hits.size(); ++i) {
+        const auto& hit = hits[i];
+        out += fmt::format("{}. {} (ID {}, score {:.2f})\n   {}\n", i + 1, hit.model.*Table::label,
+            hit.model.id, hit.score, hit.snippet);
+    }
+    std::cout << out;
+    return static_cast<int>(hits.size());
+}
+
+template <typename Model>
+std::vector<Model> Repository<Model>::findRange(const std::string& field, const std::string& op, long long low,
+    long long high, size_t limit) {
+    if (!isIntegerColumn<Model>(field)) {
+        spdlog::error("{} column '{}' is not numeric", Table::entity, field);
+        return {};
+    }
+    std::optional<Predicate::Op> comparison = comparisonOp(op);
+    if (!comparison || *comparison == Predicate::Op::In) {
+        spdlog::error("Invalid range operator: {}", op);
+        return {};
+    }
+    std::vector<QueryValue> values{ low };
+    if (*comparison == Predicate::Op::Between) {
+        values.push_back(high);
+    }
+    Query<Model> query;
+    query.where(Predicate(field, *comparison, std::move(values))).orderBy(field).limit(limit);
+    // Unknown derived dates are stored as 0 and never fall in a range
+    if (isDerivedColumn<Model>(field)) {
+        query.where(Predicate(field, Predicate::Op::Greater, { 0LL }));
+    }
+    std::vector<Model> models = select(query);
+    spdlog::info("Found {} {} with {} {} {}{}", models.size(), Table::plural, field, op, low,
+        *comparison == Predicate::Op::Between ? fmt::format(" and {}", high) : "");
+    return models;
+}
+
+template <typename Model>
+int Repository<Model>::showRange(const std::string& field, const std::string& op, long long low,
+    long long high, size_t limit) {
+    std::vector<Model> models = findRange(field, op, low, high, limit);
+    printTable(models);
+    return static_cast<int>(models.size());
+}
+
+template <typename Model>
+std::vector<Model> Repository<Model>::findPrefix(const std::string& prefix, size_t limit) {
+    std::vector<Model> models;
+    const TableSQL& sql = tableSQL<Model>();
+    const std::string_view text = trimName(prefix);
+    if (sql.name_prefix.empty() || text.empty()) {
+        return models;
+    }
+    try {
+        // Shorter prefixes contain no trigram to look up; LIKE only folds ASCII case
+        const bool indexed = fuzzy::fold(text).size() >= fuzzy::min_similar_length;
+        auto conn = pool_.reader();
+        auto query = conn->statements().get(indexed ? sql.name_prefix : sql.name_like);
+        query->bind(1, indexed ? fuzzy::prefixQuery(text) : likePrefix(text));
+        query->bind(2, static_cast<long long>(limit));
+        Model model(trusted_row);
+        while (query->executeStep()) {
+            readRow(*query, model);
+            models.push_back(std::move(model));
+        }
+        spdlog::info("Prefix lookup '{}' found {} {}", text, models.size(), Table::plural);
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to look up {} starting with '{}': {}", Table::plural, text, e.what());
+    }
+    return models;
+}
+
+template <typename Model>
+std::vector<NameMatch<Model>> Repository<Model>::findSimilar(const std::string& text, size_t max_distance, size_t limit) {
+    std::vector<NameMatch<Model>> matches;
+    const TableSQL& sql = tableSQL<Model>();
+    const std::string_view name = trimName(text);
+    if (sql.name_similar.empty() || name.empty()) {
+        return matches;
+    }
+    const std::u32string folded = fuzzy::fold(name);
+    // Shorter text has no trigram to look up, and a prefix match would
+    // silently drop the typo tolerance
+    if (folded.size() < fuzzy::min_similar_length) {
+        throw std::invalid_argument(fmt::format("Similar-name search needs at least {} characters; "
+            "use the prefix search for shorter names", fuzzy::min_similar_length));
+    }
+    try {
+        const std::string expression = fuzzy::trigramQuery(name);
+        auto conn = pool_.reader();
+        // Names sharing the most trigrams come first; only they are measured
+        auto query = conn->statements().get(sql.name_similar);
+        query->bind(1, expression);
+        query->bind(2, static_cast<long long>(std::max<size_t>(limit * 10, 200)));
+        Model model(trusted_row);
+        size_t candidates = 0;
+        while (query->executeStep()) {
+            readRow(*query, model);
+            ++candidates;
+            const size_t distance = fuzzy::nameDistance(folded, fuzzy::fold(nameOf(model)), max_distance);
+            if (distance <= max_distance) {
+                matches.push_back(NameMatch<Model>{ std::move(model), distance });
+            }
+        }
+        std::stable_sort(matches.begin(), matches.end(), [](const auto& a, const auto& b) {
+            return a.distance < b.distance;
+        });
+        if (matches.size() > limit) {
+            matches.erase(matches.begin() + limit, matches.end());
+        }
+        spdlog::info("Fuzzy lookup '{}' matched {} of {} candidate {}", name, matches.size(), candidates, Table::plural);
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to look up {} similar to '{}': {}", Table::plural, name, e.what());
+    }
+    return matches;
+}
+
+template <typename Model>
+int Repository<Model>::showPrefix(const std::string& prefix, size_t limit) {
+    std::vector<Model> models = findPrefix(prefix, limit);
+    printTable(models);
+    return static_cast<int>(models.size());
+}
+
+template <typename Model>
+int Repository<Model>::showSimilar(const std::string& text, size_t max_distance, size_t limit) {
+    std::vector<NameMatch<Model>> matches = findSimilar(text, max_distance, limit);
+    std::string out;
+    for (size_t i = 0; i < matches.size(); ++i) {
+        const auto& match = matches[i];
+        out += fmt::format("{}. {} (ID {}, distance {})\n", i + 1, match.model.*Table::label,
+            match.model.id, match.distance);
+    }
+    std::cout << out;
+    return static_cast<int>(matches.size());
+}
+
+template <typename Model>
+std::string Repository<Model>::showPage(RowQuery query, size_t page_size) {
+    if (page_size == 0) {
+        page_size = 1;
+    }
+    // One extra row tells whether another page follows
+    query.limit = page_size + 1;
+    std::vector<Model> models = collect(query);
+    std::string next;
+    if (models.size() > page_size) {
+        models.pop_back();
+        bool null = false;
+        if (!query.order_by.empty()) {
+            try {
+                auto conn = pool_.reader();
+                auto key = conn->statements().get("SELECT " + query.order_by + " IS NULL FROM " +
+                    Table::table + " WHERE id = ?");
+                key->bind(1, static_cast<long long>(models.back().id));
+                null = key->executeStep() && key->getColumn(0).getInt() != 0;
+            }
+            catch (const SQLite::Exception& e) {
+                spdlog::error("Failed to read the {} page position: {}", Table::table, e.what());
+            }
+        }
+        next = pageToken(models.back(), query.order_by, null);
+    }
+    spdlog::info("Showing {} {} after '{}'{}", models.size(), Table::plural, query.after,
+        next.empty() ? ", last page" : "");
+    printTable(models);
+    return next;
+}
+
+template <typename Model>
+bool Repository<Model>::update(const std::string& field, const int& id, const std::string& new_val) {
+    if (!hasColumn<Model>(field)) {
+        spdlog::error("Unknown {} column '{}'", Table::table, field);
+        return false;
+    }
+    try {
+        auto conn = pool_.writer();
+        // The changed row may collide with later imports, rebuild the index next time
+        dedup_.unload();
+        // The row and its derived columns change together, readers never see one without the other
+        SQLite::Transaction transaction(conn->db());
+        auto check_query = conn->statements().get(std::string("SELECT 1 FROM ") + Table::table + " WHERE id = ?");
+        check_query->bind(1, id);
+        bool exists = check_query->executeStep();
+        if (!exists) {
+            spdlog::warn("{} '{}' not found for update", Table::entity, id);
+            return false;
+        }
+        std::string query_str = std::string("UPDATE ") + Table::table + " SET " + field + " = ? WHERE id = ?";
+        auto query = conn->statements().get(query_str);
+        query->bind(1, new_val);
+        query->bind(2, id);
+        query->exec();
+        // Derived columns follow the changed row
+        if (!tableSQL<Model>().update_derived.empty()) {
+            auto row_query = conn->statements().get(tableSQL<Model>().select_row);
+            row_query->bind(1, id);
+            if (row_query->executeStep()) {
+                Model model(trusted_row);
+                readRow(*row_query, model);
+                derive(model);
+                auto derived_query = conn->statements().get(tableSQL<Model>().update_derived);
+                bindDerived(*derived_query, model);
+                derived_query->exec();
+            }
+        }
+        transaction.commit();
+        spdlog::info("Updated field '{}' for {} '{}' to '{}'", field, Table::table, id, new_val);
+        return true;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to update {} '{}': {}", Table::table, id, e.what());
+        return false;
+    }
+}
+
+template <typename Model>
+bool Repository<Model>::del(const std::string& field, const std::string& value) {
+    if (!hasColumn<Model>(field)) {
+        spdlog::error("Unknown {} column '{}'", Table::table, field);
+        return false;
+    }
+    try {
+        advisor_.record(Table::table, field);
+        auto conn = pool_.writer();
+        std::string check_query_str = std::string("SELECT 1 FROM ") + Table::table + " WHERE " + field + " = ?";
+        auto check_query = conn->statements().get(check_query_str);
+        check_query->bind(1, value);
+        bool exists = check_query->executeStep();
+        if (!exists) {
+            spdlog::warn("No {} found with {} = '{}'", Table::table, field, value);
+            return false;
+        }
+        std::string query_str = std::string("DELETE FROM ") + Table::table + " WHERE " + field + " = ?";
+        auto query = conn->statements().get(query_str);
+        query->bind(1, value);
+        query->exec();
+        spdlog::info("Deleted {} with {} = '{}'", Table::table, field, value);
+        return true;
+    }
+    catch (const SQLite::Exception& e) {
+        spdlog::error("Failed to delete {} with {} = '{}': {}", Table::table, field, value, e.what());
+        return false;
+    }
+}
+
+template <typename Model>
+void Repository<Model>::filter(const std::string& field, const std::string& direction) {
+    if (direction != "up" && direction != "down") {
+        spdlog::error("Invalid sort direction: {}", direction);
+        return;
+    }
+    RowQuery query;
+    query.order_by = field;
+    query.descending = direction == "down";
+    std::vector<Model> models = collect(query);
+    spdlog::info("Filtered {} {} by {} {}", models.size(), Table::plural, field, direction);
+    printTable(models);
+}
+
+template <typename Model>
+int Repository<Model>::find(const std::string& field, const std::string& value) {
+    RowQuery query;
+    query.field = field;
+    query.value = value;
+    std::vector<Model> models = collect(query);
+    spdlog::info("Found {} {} with {} = '{}'", models.size(), Table::plural, field, value);
+    printTable(models);
+    return models.size();
+}
+
+template <typename Model>
+void Repository<Model>::exportData(const std::string& format_type) {
+    try {
+        auto conn = pool_.reader();
+        const TableSQL& sql = tableSQL<Model>();
+        const std::string path = std::string("C:/Users/kos22/CLionProjects/library/export/") + Table::table + "_export";
+        if (format_type == "csv") {
+            CSVWriter writer(path + ".csv");
+            if (!writer.isOpen()) {
+                spdlog::error("Failed to open CSV file for export");
+                throw std::runtime_error("Failed to open CSV file");
+            }
+            // Write UTF-8 BOM
+            writer.writeRaw("\xEF\xBB\xBF");
+            writer.writeRaw(sql.export_header);
+            // Stream rows straight from the cursor
+            auto query = conn->statements().get(sql.exported);
+            while (query->executeStep()) {
+                for (int i = 0; i < query->getColumnCount(); ++i) {
+                    writer.field(query->getColumn(i));
+                }
+                writer.endRow();
+            }
+            writer.close();
+            spdlog::info("Exported {} {} to CSV", writer.rows(), Table::plural);
+        }
+        else if (auto style = JSONWriter::styleFor(format_type)) {
+            JSONWriter writer(path + (*style == JSONStyle::Lines ? ".ndjson" : ".json"), *style);
+            if (!writer.isOpen()) {
+                spdlog::error("Failed to open JSON file for export");
+                throw std::runtime_error("Failed to open JSON file");
+            }
+            auto query = conn->statements().get(sql.exported);
+            while (query->executeStep()) {
+                writer.beginObject();
+                for (size_t i : sql.json_order) {
+                    writer.key(sql.export_keys[i]);
+                    writer.value(query->getColumn(static_cast<int>(i)));
+                }
+                writer.endObject();
+            }
+            writer.close();
+            spdlog::info("Exported {} {} to {}", writer.objects(), Table::plural, format_type);
+        }
+        else {
+            spdlog::error("Invalid export format: {}", format_type);
+            throw std::invalid_argument("Invalid export format");
+        }
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Failed to export {}: {}", Table::plural, e.what());
+    }
+}
+
+template class Repository<Book>;
+template class Repository<Author>;
+template class Repository<Publisher>;
+template class Repository<Genre>;
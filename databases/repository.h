@@ -0,0 +1,130 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <SQLiteCpp/SQLiteCpp.h>
+#include "connection_pool.h"
+#include "index_advisor.h"
+#include "dedup_index.h"
+#include "import_checkpoint.h"
+#include "table_schema.h"
+#include "query.h"
+
+// Rows visited by Repository::forEach
+struct RowQuery {
+    // WHERE field = value; empty field selects every row
+    std::string field;
+    std::string value;
+    // ORDER BY order_by; empty keeps the table order
+    std::string order_by;
+    bool descending = false;
+    // Stop after this many rows, 0 for all
+    size_t limit = 0;
+    // Continuation token of a page; only rows after it in (order_by, id)
+    // order are visited, with NULL keys first ascending and last descending.
+    // Seeks through the index instead of using OFFSET.
+    std::string after;
+};
+
+// Called for each row; return false to stop. The model is reused for the
+// next row, so move out of it to keep it.
+template <typename Model>
+using RowVisitor = std::function<bool(Model&)>;
+
+// One full-text match: the row, its bm25 score (higher is better) and a
+// snippet of the best matching column with the terms in [brackets]
+template <typename Model>
+struct SearchHit {
+    Model model;
+    double score;
+    std::string snippet;
+};
+
+// A row whose name is within the edit-distance cutoff of a fuzzy lookup
+template <typename Model>
+struct NameMatch {
+    Model model;
+    size_t distance;
+};
+
+// Storage of one model in its table. Binding, hydration, duplicate checks,
+// printing and export are generated from the column list in Schema<Model>,
+// so all entities share one implementation of every query path.
+template <typename Model>
+class Repository {
+private:
+    using Table = Schema<Model>;
+
+    ConnectionPool& pool_;
+    IndexAdvisor& advisor_;
+    // Guarded by the writer lease
+    DedupIndex dedup_;
+
+    bool initializeTextIndexes();
+    void readRow(SQLite::Statement& query, Model& model);
+    bool exists(Connection& conn, const Model& model);
+    void addDerivedColumns(Connection& conn);
+    size_t visitRows(const std::string& sql, const std::vector<QueryValue>& values, const RowVisitor<Model>& visit);
+    std::vector<Model> collect(const RowQuery& query);
+    void printTable(const std::vector<Model>& models);
+
+public:
+    Repository(ConnectionPool& pool, IndexAdvisor& advisor);
+    bool initialize();
+    bool exists(const Model& model);
+    // Load existing keys before an import and drop them afterwards
+    bool beginImport();
+    void endImport();
+    int save(Model& model);
+    // before_commit runs inside the batch transaction, e.g. to store an import checkpoint.
+    // Returns the rows inserted (0 if all were duplicates), or -1 if the batch was rolled back.
+    int saveBatch(std::vector<Model>& models, const BatchCommitHook& before_commit = {});
+    // Streams matching rows from the cursor without building a vector; the
+    // visitor runs while a reader connection is borrowed. Returns the number
+    // of rows visited, or 0 after logging on failure.
+    size_t forEach(const RowQuery& query, const RowVisitor<Model>& visit);
+    // Same for a composed query: one statement for all its conditions, sort
+    // keys and limit, prepared once per query shape
+    size_t forEach(const Query<Model>& query, const RowVisitor<Model>& visit);
+    std::vector<Model> select(const Query<Model>& query);
+    // Prints the rows of select and returns their number
+    int show(const Query<Model>& query);
+    void showAll();
+    // Ranked full-text search over the FullText columns; every word must
+    // match, a trailing * matches a prefix
+    std::vector<SearchHit<Model>> searchText(const std::string& terms, size_t limit = 20);
+    // Prints the hits of searchText and returns their number
+    int showSearch(const std::string& terms, size_t limit = 20);
+    // Rows whose integer column compares with low: op is =, <>, <, <=, >, >=,
+    // or between for low..high inclusive. Values are bound as integers, so the
+    // column's index serves the range; author dates are yyyymmdd numbers.
+    std::vector<Model> findRange(const std::string& field, const std::string& op, long long low,
+        long long high = 0, size_t limit = 0);
+    int showRange(const std::string& field, const std::string& op, long long low,
+        long long high = 0, size_t limit = 0);
+    // Rows whose name (the Trigram column) starts with prefix, ignoring case,
+    // in name order
+    std::vector<Model> findPrefix(const std::string& prefix, size_t limit = 20);
+    // Rows whose name, or a run of as many words of it, is at most
+    // max_distance edits from text, closest first. Candidates come from the
+    // trigram index, so a typo costs one lookup instead of a table scan.
+    // Throws std::invalid_argument for text under 3 characters, which has no
+    // trigram; use findPrefix for those.
+    std::vector<NameMatch<Model>> findSimilar(const std::string& text, size_t max_distance = 2, size_t limit = 20);
+    // Print the rows of findPrefix and findSimilar and return their number
+    int showPrefix(const std::string& prefix, size_t limit = 20);
+    int showSimilar(const std::string& text, size_t max_distance = 2, size_t limit = 20);
+    // Prints up to page_size rows of query and returns the token of the
+    // next page, empty after the last one
+    std::string showPage(RowQuery query, size_t page_size);
+    bool update(const std::string& field, const int& id, const std::string& new_val);
+    bool del(const std::string& field, const std::string& value);
+    void filter(const std::string& field, const std::string& direction);
+    int find(const std::string& field, const std::string& value);
+    void exportData(const std::string& format_type);
+};
+
+extern template class Repository<Book>;
+extern template class Repository<Author>;
+extern template class Repository<Publisher>;
+extern template class Repository<Genre>;
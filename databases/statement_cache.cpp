@@ -0,0 +1,68 @@
+#include "statement_cache.h"
+#include <spdlog/spdlog.h>
+
+StatementCache::Handle::Handle(SQLite::Statement& statement, bool& in_use)
+    : statement_(&statement), in_use_(&in_use) {
+    in_use = true;
+}
+
+StatementCache::Handle::Handle(std::unique_ptr<SQLite::Statement> owned)
+    : statement_(owned.get()), in_use_(nullptr), owned_(std::move(owned)) {
+}
+
+StatementCache::Handle::Handle(Handle&& other) noexcept
+    : statement_(other.statement_), in_use_(other.in_use_), owned_(std::move(other.owned_)) {
+    other.statement_ = nullptr;
+    other.in_use_ = nullptr;
+}
+
+StatementCache::Handle::~Handle() {
+    if (statement_ != nullptr) {
+        statement_->tryReset();
+    }
+    if (in_use_ != nullptr) {
+        *in_use_ = false;
+    }
+}
+
+StatementCache::StatementCache(SQLite::Database& db, size_t capacity) : db_(db), capacity_(capacity) {
+}
+
+StatementCache::Handle StatementCache::get(const std::string& sql) {
+    auto it = entries_.find(sql);
+    if (it != entries_.end()) {
+        if (it->second.in_use) {
+            // Same SQL requested while borrowed (nested call): use a one-off statement
+            ++misses_;
+            return Handle(std::make_unique<SQLite::Statement>(db_, sql));
+        }
+        ++hits_;
+        it->second.statement->clearBindings();
+        return Handle(*it->second.statement, it->second.in_use);
+    }
+
+    ++misses_;
+    if (entries_.size() >= capacity_) {
+        evictIdle();
+    }
+    Entry entry;
+    entry.statement = std::make_unique<SQLite::Statement>(db_, sql);
+    auto inserted = entries_.emplace(sql, std::move(entry)).first;
+    spdlog::debug("Prepared and cached statement: {}", sql);
+    return Handle(*inserted->second.statement, inserted->second.in_use);
+}
+
+void StatementCache::evictIdle() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (!it->second.in_use) {
+            it = entries_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void StatementCache::clear() {
+    evictIdle();
+}
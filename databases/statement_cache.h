@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <SQLiteCpp/SQLiteCpp.h>
+
+// Prepared statements of one connection, keyed by their SQL text.
+// Repeated calls only reset and rebind instead of preparing again.
+class StatementCache {
+private:
+    struct Entry {
+        std::unique_ptr<SQLite::Statement> statement;
+        bool in_use = false;
+    };
+
+    SQLite::Database& db_;
+    size_t capacity_;
+    std::unordered_map<std::string, Entry> entries_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+
+    void evictIdle();
+
+public:
+    // Borrowed statement; it is reset when the handle goes out of scope,
+    // so a cached statement never keeps a read cursor open between calls
+    class Handle {
+    private:
+        SQLite::Statement* statement_;
+        bool* in_use_;
+        std::unique_ptr<SQLite::Statement> owned_;
+
+    public:
+        Handle(SQLite::Statement& statement, bool& in_use);
+        explicit Handle(std::unique_ptr<SQLite::Statement> owned);
+        Handle(Handle&& other) noexcept;
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        ~Handle();
+
+        SQLite::Statement& operator*() { return *statement_; }
+        SQLite::Statement* operator->() { return statement_; }
+    };
+
+    explicit StatementCache(SQLite::Database& db, size_t capacity = 128);
+    Handle get(const std::string& sql);
+    void clear();
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+    size_t size() const { return entries_.size(); }
+};
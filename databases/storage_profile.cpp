@@ -0,0 +1,24 @@
+#include "storage_profile.h"
+
+StorageProfile StorageProfile::bulkLoad() {
+    return { "bulk-load", "WAL", "NORMAL", 256 * 1024, 0, "MEMORY", 30000 };
+}
+
+StorageProfile StorageProfile::interactive() {
+    return { "interactive", "WAL", "NORMAL", 16 * 1024, 256LL * 1024 * 1024, "MEMORY", 5000 };
+}
+
+StorageProfile StorageProfile::readOnlyAnalytics() {
+    return { "read-only-analytics", "WAL", "NORMAL", 64 * 1024, 1024LL * 1024 * 1024, "MEMORY", 10000 };
+}
+
+std::optional<StorageProfile> StorageProfile::byName(const std::string& name) {
+    if (name == "bulk-load") return bulkLoad();
+    if (name == "interactive") return interactive();
+    if (name == "read-only-analytics") return readOnlyAnalytics();
+    return std::nullopt;
+}
+
+std::vector<std::string> StorageProfile::names() {
+    return { "bulk-load", "interactive", "read-only-analytics" };
+}
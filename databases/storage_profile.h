@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+#include <optional>
+#include <vector>
+
+// SQLite PRAGMA settings applied to every connection of the pool
+struct StorageProfile {
+    std::string name;
+    std::string journal_mode;   // WAL, DELETE, TRUNCATE, MEMORY, OFF
+    std::string synchronous;    // OFF, NORMAL, FULL, EXTRA
+    int cache_size_kib;         // page cache per connection
+    long long mmap_size;        // bytes, 0 disables memory-mapped I/O
+    std::string temp_store;     // DEFAULT, FILE, MEMORY
+    int busy_timeout_ms;
+
+    // Few, large transactions: WAL syncs only on checkpoint, big cache
+    static StorageProfile bulkLoad();
+    // Short reads and single-row writes from the menu
+    static StorageProfile interactive();
+    // Long scans for exports and joins
+    static StorageProfile readOnlyAnalytics();
+
+    static std::optional<StorageProfile> byName(const std::string& name);
+    static std::vector<std::string> names();
+};
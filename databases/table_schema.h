@@ -0,0 +1,201 @@
+#pragma once
+#include <string>
+#include <tuple>
+#include "C:/Users/kos22/CLionProjects/library/models/book.h"
+#include "C:/Users/kos22/CLionProjects/library/models/author.h"
+#include "C:/Users/kos22/CLionProjects/library/models/publisher.h"
+#include "C:/Users/kos22/CLionProjects/library/models/genre.h"
+
+namespace column_flags {
+    inline constexpr unsigned None = 0;
+    // Generated by SQLite, never bound on insert
+    inline constexpr unsigned PrimaryKey = 1;
+    // Part of the duplicate check on save and import
+    inline constexpr unsigned DedupKey = 2;
+    // Stored and loaded, but not printed or exported
+    inline constexpr unsigned Hidden = 4;
+    // Indexed in the table's FTS5 full-text index
+    inline constexpr unsigned FullText = 8;
+    // The name of a row, indexed by trigrams for prefix and typo-tolerant lookups
+    inline constexpr unsigned Trigram = 16;
+    // Computed from other columns by Schema::loaded, 0 when unknown. Stored so
+    // it can be range-searched through an index; rewritten when the row changes.
+    inline constexpr unsigned Derived = 32;
+}
+
+// One table column mapped to a model member
+template <typename Model, typename Field>
+struct ColumnDef {
+    using model_type = Model;
+    using field_type = Field;
+
+    const char* name;           // SQL column
+    Field Model::* member;
+    const char* heading;        // header of the printed table
+    const char* export_key;     // CSV header and JSON key
+    int width;                  // initial width in the printed table
+    unsigned flags;
+
+    constexpr bool has(unsigned flag) const { return (flags & flag) != 0; }
+};
+
+template <typename Model, typename Field>
+constexpr ColumnDef<Model, Field> column(const char* name, Field Model::* member, const char* heading,
+    const char* export_key, int width, unsigned flags = column_flags::None) {
+    return ColumnDef<Model, Field>{ name, member, heading, export_key, width, flags };
+}
+
+// Table layout of a model; columns are listed in SELECT, print and export order
+template <typename Model>
+struct Schema;
+
+template <>
+struct Schema<Book> {
+    static constexpr const char* table = "book";
+    static constexpr const char* entity = "Book";
+    static constexpr const char* plural = "books";
+    // Member shown in log messages
+    static constexpr auto label = &Book::title;
+
+    static constexpr const char* create_sql = "CREATE TABLE IF NOT EXISTS book ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "title TEXT NOT NULL, "
+        "author_id INTEGER NOT NULL, "
+        "year INTEGER, "
+        "genre_id INTEGER, "
+        "pages INTEGER, "
+        "description TEXT, "
+        "publisher_id INTEGER NOT NULL, "
+        "FOREIGN KEY (author_id) REFERENCES author_id(id), "
+        "FOREIGN KEY (genre_id) REFERENCES genre_id(id), "
+        "FOREIGN KEY (publisher_id) REFERENCES publisher_id(id))";
+    // Indexes for lookups, sorting and the dedup check
+    static constexpr const char* indexes[] = {
+        "CREATE INDEX IF NOT EXISTS idx_book_title ON book(title)",
+        "CREATE INDEX IF NOT EXISTS idx_book_author_id ON book(author_id)",
+        "CREATE INDEX IF NOT EXISTS idx_book_genre_id ON book(genre_id)",
+        "CREATE INDEX IF NOT EXISTS idx_book_publisher_id ON book(publisher_id)",
+        "CREATE INDEX IF NOT EXISTS idx_book_year ON book(year)"
+    };
+
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Book::id, "ID", "ID", 5, column_flags::PrimaryKey),
+        column("title", &Book::title, "title", "title", 20,
+            column_flags::DedupKey | column_flags::FullText | column_flags::Trigram),
+        column("author_id", &Book::author_id, "author", "author_id", 6, column_flags::DedupKey),
+        column("year", &Book::year, "year", "year", 7, column_flags::DedupKey),
+        column("genre_id", &Book::genre_id, "genre", "genre_id", 5, column_flags::DedupKey),
+        column("pages", &Book::pages, "pages", "pages", 5, column_flags::DedupKey),
+        column("publisher_id", &Book::publisher_id, "publisher", "publisher_id", 7, column_flags::DedupKey),
+        column("description", &Book::description, "description", "description", 0,
+            column_flags::Hidden | column_flags::FullText)
+    );
+};
+
+template <>
+struct Schema<Author> {
+    static constexpr const char* table = "author";
+    static constexpr const char* entity = "Author";
+    static constexpr const char* plural = "authors";
+    static constexpr auto label = &Author::full_name;
+
+    static constexpr const char* create_sql = "CREATE TABLE IF NOT EXISTS author ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "full_name TEXT, "
+        "date_of_birth TEXT, "
+        "date_of_death TEXT, "
+        "biography TEXT, "
+        "birth_date INTEGER NOT NULL DEFAULT 0, "
+        "death_date INTEGER NOT NULL DEFAULT 0)";
+    static constexpr const char* indexes[] = {
+        "CREATE INDEX IF NOT EXISTS idx_author_full_name ON author(full_name)",
+        "CREATE INDEX IF NOT EXISTS idx_author_birth_date ON author(birth_date)",
+        "CREATE INDEX IF NOT EXISTS idx_author_death_date ON author(death_date)"
+    };
+
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Author::id, "id", "id", 3, column_flags::PrimaryKey),
+        column("full_name", &Author::full_name, "full_name", "full_name", 20,
+            column_flags::DedupKey | column_flags::FullText | column_flags::Trigram),
+        column("date_of_birth", &Author::date_of_birth, "birth", "date_of_birth", 10),
+        column("date_of_death", &Author::date_of_death, "death", "date_of_death", 10),
+        column("biography", &Author::biography, "biography", "biography", 50, column_flags::FullText),
+        // yyyymmdd copies of the dates above for range queries
+        column("birth_date", &Author::birth_date, "birth_date", "birth_date", 8,
+            column_flags::Hidden | column_flags::Derived),
+        column("death_date", &Author::death_date, "death_date", "death_date", 8,
+            column_flags::Hidden | column_flags::Derived)
+    );
+
+    // The text dates are authoritative, the parsed ones follow them when written
+    static void derive(Author& author) {
+        author.birth_date = validation::tryParseDate(author.date_of_birth);
+        author.death_date = validation::tryParseDate(author.date_of_death);
+    }
+};
+
+template <>
+struct Schema<Publisher> {
+    static constexpr const char* table = "publisher";
+    static constexpr const char* entity = "Publisher";
+    static constexpr const char* plural = "publishers";
+    static constexpr auto label = &Publisher::name;
+
+    static constexpr const char* create_sql = "CREATE TABLE IF NOT EXISTS publisher ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "name TEXT NOT NULL, "
+        "address TEXT, "
+        "phone TEXT, "
+        "mail TEXT)";
+    static constexpr const char* indexes[] = {
+        "CREATE INDEX IF NOT EXISTS idx_publisher_name ON publisher(name)"
+    };
+
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Publisher::id, "ID", "ID", 5, column_flags::PrimaryKey),
+        column("name", &Publisher::name, "title", "title", 15,
+            column_flags::DedupKey | column_flags::FullText | column_flags::Trigram),
+        column("address", &Publisher::address, "address", "address", 30, column_flags::FullText),
+        column("phone", &Publisher::phone, "phone", "phone", 10),
+        column("mail", &Publisher::mail, "mail", "mail", 20)
+    );
+};
+
+template <>
+struct Schema<Genre> {
+    static constexpr const char* table = "genre";
+    static constexpr const char* entity = "Genre";
+    static constexpr const char* plural = "genres";
+    static constexpr auto label = &Genre::title;
+
+    static constexpr const char* create_sql = "CREATE TABLE IF NOT EXISTS genre ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "title TEXT NOT NULL, "
+        "description TEXT)";
+    static constexpr const char* indexes[] = {
+        "CREATE INDEX IF NOT EXISTS idx_genre_title ON genre(title)"
+    };
+
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Genre::id, "ID", "ID", 3, column_flags::PrimaryKey),
+        column("title", &Genre::title, "title", "title", 15,
+            column_flags::DedupKey | column_flags::FullText | column_flags::Trigram),
+        column("description", &Genre::description, "description", "description", 50, column_flags::FullText)
+    );
+};
+
+// Calls f(column) for every column of Model in declaration order
+template <typename Model, typename F>
+constexpr void forEachColumn(F&& f) {
+    std::apply([&](const auto&... columns) { (f(columns), ...); }, Schema<Model>::columns);
+}
+
+// True if name is one of the mapped columns of Model
+template <typename Model>
+bool hasColumn(const std::string& name) {
+    bool found = false;
+    forEachColumn<Model>([&](const auto& column) {
+        found = found || name == column.name;
+    });
+    return found;
+}
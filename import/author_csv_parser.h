@@ -3,13 +3,17 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/author_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/author.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class CSVAuthorReader {
 private:
     AuthorRepository& repo_;
     std::string csv_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    CSVAuthorReader(const std::string& file, AuthorRepository& repo);
+    CSVAuthorReader(const std::string& file, AuthorRepository& repo, const BulkImportOptions& options = {});
     std::vector<Author> loadFromCSV();
+    const ImportStats& stats() const { return stats_; }
 };
\ No newline at end of file
@@ -4,13 +4,19 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/author_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/author.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class JSONAuthorReader {
 private:
     AuthorRepository& repo_;
     std::string json_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    JSONAuthorReader(const std::string& file, AuthorRepository& repo);
+    JSONAuthorReader(const std::string& file, AuthorRepository& repo, const BulkImportOptions& options = {});
     std::vector<Author> loadFromJSON();
+    // One JSON object per line, parsed on options.workers threads
+    std::vector<Author> loadFromNDJSON();
+    const ImportStats& stats() const { return stats_; }
 };
\ No newline at end of file
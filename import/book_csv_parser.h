@@ -4,13 +4,17 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/book_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/book.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class CSVBookReader {
 private:
     BookRepository& repo_;
     std::string csv_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    CSVBookReader(const std::string& file, BookRepository& repo);
+    CSVBookReader(const std::string& file, BookRepository& repo, const BulkImportOptions& options = {});
     std::vector<Book> loadFromCSV();
+    const ImportStats& stats() const { return stats_; }
 };
\ No newline at end of file
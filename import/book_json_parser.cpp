@@ -1,95 +1,140 @@
 #include "book_json_parser.h"
+#include "json_stream_reader.h"
+#include "input_stream.h"
+#include "import_pipeline.h"
+#include "record_source.h"
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
-#include <fstream>
 #include <set>
 #include <algorithm>
 
-JSONBookReader::JSONBookReader(const std::string& file, BookRepository& repo)
-    : repo_(repo), json_file_(file) {
+namespace {
+    const std::set<std::string> required_fields = {
+        "Title", "Author", "Genre", "Year",
+        "Pages", "Description", "Publisher"
+    };
+
+    // Comma-separated list of the required fields item lacks; empty if none
+    std::string missingFields(const nlohmann::json& item) {
+        std::string missing;
+        for (const auto& field : required_fields) {
+            if (!item.contains(field)) {
+                missing += field + ", ";
+            }
+        }
+        if (!missing.empty()) missing = missing.substr(0, missing.size() - 2);
+        return missing;
+    }
+
+    Book bookFromJSON(const nlohmann::json& item) {
+        return Book(
+            item["Title"].get<std::string>(),
+            item["Author"].get<int>(),
+            item["Description"].get<std::string>(),
+            item["Year"].get<int>(),
+            item["Genre"].get<int>(),
+            item["Publisher"].get<int>(),
+            item["Pages"].get<int>()
+        );
+    }
+}
+
+JSONBookReader::JSONBookReader(const std::string& file, BookRepository& repo, const BulkImportOptions& options)
+    : repo_(repo), json_file_(file), options_(options) {
     spdlog::info("JSONBookReader initialized with file: {}", json_file_);
 }
 
 std::vector<Book> JSONBookReader::loadFromJSON() {
     spdlog::info("Loading JSON from file: {}", json_file_);
     std::vector<Book> books;
+    BatchWriter<Book, BookRepository> writer(repo_, options_, books);
     try {
-        std::ifstream file(json_file_);
+        // .gz/.zst files are decompressed on a background thread
+        ImportInputStream file(json_file_);
         if (!file.is_open()) {
             spdlog::error("Failed to open JSON file: {}", json_file_);
             return books;
         }
 
-        nlohmann::json json_data;
-        file >> json_data;
-        file.close();
-
-        // Check if json_data is an array
-        if (!json_data.is_array()) {
-            spdlog::error("JSON is not an array");
-            return books;
-        }
-
-        std::set<std::string> required_fields = {
-            "Title", "Author", "Genre", "Year",
-            "Pages", "Description", "Publisher"
-        };
         int row_number = 1;
 
-        for (const auto& item : json_data) {
+        // Rows are validated and saved as soon as each array element is parsed
+        bool is_array = JSONArrayStream::parse(file, [&](const nlohmann::json& item) {
             spdlog::debug("Processing row: {}", row_number);
 
-            // Check for required fields
-            std::set<std::string> item_keys;
-            for (auto it = item.begin(); it != item.end(); ++it) {
-                item_keys.insert(it.key());
-            }
-
-            std::set<std::string> missing_fields;
-            std::set_difference(
-                required_fields.begin(), required_fields.end(),
-                item_keys.begin(), item_keys.end(),
-                std::inserter(missing_fields, missing_fields.begin())
-            );
-            if (!missing_fields.empty()) {
-                std::string missing;
-                for (const auto& field : missing_fields) {
-                    missing += field + ", ";
-                }
-                if (!missing.empty()) missing = missing.substr(0, missing.size() - 2);
+            std::string missing = missingFields(item);
+            if (!missing.empty()) {
                 spdlog::warn("Missing fields in row {}: {}", row_number, missing);
                 throw std::runtime_error("JSON does not contain required headers");
             }
 
             try {
-                Book book(
-                    item["Title"].get<std::string>(),
-                    item["Author"].get<int>(),
-                    item["Description"].get<std::string>(),
-                    item["Year"].get<int>(),
-                    item["Genre"].get<int>(),
-                    item["Publisher"].get<int>(),
-                    item["Pages"].get<int>()
-                );
-                if (repo_.save(book) != -1) {
-                    books.push_back(book);
-                } else {
+                Book book = bookFromJSON(item);
+                if (!writer.add(book)) {
                     spdlog::warn("Book already exists in row {}: {}", row_number, item["Title"].get<std::string>());
                 }
             }
+            catch (const ImportWriteError&) {
+                throw;
+            }
             catch (const std::exception& e) {
                 spdlog::warn("Error parsing row {}: {}", row_number, e.what());
             }
             ++row_number;
+        });
+        file.close();
+
+        if (!is_array) {
+            spdlog::error("JSON is not an array");
         }
 
-        spdlog::info("Loaded {} books from JSON", books.size());
+        stats_ = writer.finish("book");
+        spdlog::info("Loaded {} books from JSON", stats_.imported);
         return books;
     }
     catch (const std::exception& e) {
         spdlog::error("Error reading JSON: {}", e.what());
+        stats_ = writer.finish("book");
         return books;
     }
-}
\ No newline at end of file
+}
+
+std::vector<Book> JSONBookReader::loadFromNDJSON() {
+    spdlog::info("Loading NDJSON from file: {}", json_file_);
+    std::vector<Book> books;
+    BatchWriter<Book, BookRepository> writer(repo_, options_, books);
+    try {
+        RecordSource source(json_file_, RecordFormat::Lines, options_.chunk_size);
+        if (!source.isOpen()) {
+            spdlog::error("Failed to open NDJSON file: {}", json_file_);
+            return books;
+        }
+
+        // Rows committed by an interrupted import are skipped without parsing
+        if (source.seekable()) {
+            source.seek(writer.resume(json_file_, source.recordsOffset(), source.size()));
+        }
+
+        // Lines are independent, so byte ranges split at newlines are parsed on worker threads
+        ImportPipeline<Book> pipeline(options_.workers, options_.queue_depth);
+        pipeline.run(source, jsonLinesParser<Book>([](const nlohmann::json& item) {
+            std::string missing = missingFields(item);
+            if (!missing.empty()) {
+                throw std::runtime_error("Missing fields: " + missing);
+            }
+            return bookFromJSON(item);
+        }), writer);
+
+        writer.complete();
+        stats_ = writer.finish("book");
+        spdlog::info("Loaded {} books from NDJSON", stats_.imported);
+        return books;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error reading NDJSON: {}", e.what());
+        stats_ = writer.finish("book");
+        return books;
+    }
+}
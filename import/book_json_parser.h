@@ -4,13 +4,19 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/book_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/book.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class JSONBookReader {
 private:
     BookRepository& repo_;
     std::string json_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    JSONBookReader(const std::string& file, BookRepository& repo);
+    JSONBookReader(const std::string& file, BookRepository& repo, const BulkImportOptions& options = {});
     std::vector<Book> loadFromJSON();
+    // One JSON object per line, parsed on options.workers threads
+    std::vector<Book> loadFromNDJSON();
+    const ImportStats& stats() const { return stats_; }
 };
\ No newline at end of file
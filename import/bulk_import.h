@@ -0,0 +1,177 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <spdlog/spdlog.h>
+#include "C:/Users/kos22/CLionProjects/library/databases/import_checkpoint.h"
+#include "C:/Users/kos22/CLionProjects/library/models/validation.h"
+
+// Settings of the transactional bulk-import mode shared by all readers
+struct BulkImportOptions {
+    bool enabled = false;
+    size_t batch_size = 1000;
+    // Return the imported models from load*(); turn off to keep memory
+    // bounded on large files and use the reader's stats() instead
+    bool keep_rows = true;
+    // Parser threads for CSV and NDJSON files; 1 parses on the writing thread
+    size_t workers = 1;
+    // Bytes of input handed to a parser thread at a time
+    size_t chunk_size = 1 << 20;
+    // Chunks buffered between pipeline stages
+    size_t queue_depth = 8;
+    // Set to make bulk CSV and NDJSON imports resumable from the last committed batch
+    CheckpointStore* checkpoints = nullptr;
+};
+
+// Outcome of one import run
+struct ImportStats {
+    size_t rows = 0;
+    size_t imported = 0;
+    double seconds = 0.0;
+
+    double rowsPerSecond() const { return seconds > 0 ? rows / seconds : 0.0; }
+};
+
+// Collects rows produced by a reader and writes them to the repository.
+// In bulk mode rows are buffered and saved batch_size at a time through
+// Repository::saveBatch (one transaction and one prepared INSERT per batch),
+// otherwise every row goes through Repository::save as before.
+template <typename Model, typename Repository>
+class BatchWriter {
+private:
+    Repository& repo_;
+    BulkImportOptions options_;
+    std::vector<Model>& saved_;
+    std::vector<Model> batch_;
+    ImportStats stats_;
+    std::chrono::steady_clock::time_point started_;
+    // Checkpointing: file being imported, position the reader started at
+    // and position after the newest buffered row
+    std::string checkpoint_file_;
+    ImportPosition base_;
+    ImportPosition position_;
+
+    bool checkpointing() const { return options_.enabled && options_.checkpoints != nullptr; }
+
+    void keep(Model& model) {
+        ++stats_.imported;
+        if (options_.keep_rows) {
+            saved_.push_back(std::move(model));
+        }
+    }
+
+public:
+    BatchWriter(Repository& repo, const BulkImportOptions& options, std::vector<Model>& saved)
+        : repo_(repo), options_(options), saved_(saved), started_(std::chrono::steady_clock::now()) {
+        if (options_.batch_size == 0) {
+            options_.batch_size = 1;
+        }
+        if (options_.enabled) {
+            batch_.reserve(options_.batch_size);
+        }
+        // Rows of this import are validated against a fresh clock reading
+        validation::refreshClock();
+        // Existing keys are loaded once so new rows skip the *Exists query
+        repo_.beginImport();
+    }
+
+    ~BatchWriter() {
+        repo_.endImport();
+    }
+
+    BatchWriter(const BatchWriter&) = delete;
+    BatchWriter& operator=(const BatchWriter&) = delete;
+
+    // Looks up the checkpoint of an interrupted import of file and starts
+    // recording new ones. records_offset is where the first data record
+    // starts; returns the byte offset to continue reading from.
+    size_t resume(const std::string& file, size_t records_offset, size_t file_size) {
+        base_ = ImportPosition{ records_offset, 0 };
+        if (!checkpointing()) {
+            return records_offset;
+        }
+        checkpoint_file_ = file;
+        auto stored = options_.checkpoints->find(file);
+        if (stored && stored->offset >= records_offset && stored->offset <= file_size) {
+            base_ = *stored;
+            spdlog::info("Resuming {} after row {}", file, base_.row);
+        }
+        return base_.offset;
+    }
+
+    // The file was read to the end, so its checkpoint is no longer needed
+    void complete() {
+        flush();
+        if (checkpointing() && !checkpoint_file_.empty()) {
+            options_.checkpoints->clear(checkpoint_file_);
+        }
+    }
+
+    // Returns false if the row was rejected as a duplicate in row-by-row mode.
+    // position is relative to the offset returned by resume(). The model may
+    // be moved from.
+    bool add(Model& model, const ImportPosition& position = {}) {
+        ++stats_.rows;
+        position_ = ImportPosition{ base_.offset + position.offset, base_.row + position.row };
+        if (!options_.enabled) {
+            if (repo_.save(model) == -1) {
+                return false;
+            }
+            // Moved out only when the rows are returned, as in bulk mode
+            keep(model);
+            return true;
+        }
+        batch_.push_back(std::move(model));
+        if (batch_.size() >= options_.batch_size) {
+            flush();
+        }
+        return true;
+    }
+
+    // Throws ImportWriteError if the batch was rolled back; later batches
+    // would move the checkpoint past its rows
+    void flush() {
+        if (batch_.empty()) {
+            return;
+        }
+        int inserted;
+        if (checkpointing() && !checkpoint_file_.empty()) {
+            // Stored in the batch transaction, so it never runs ahead of the data
+            ImportPosition position = position_;
+            inserted = repo_.saveBatch(batch_, [this, position](Connection& conn) {
+                options_.checkpoints->store(conn, checkpoint_file_, position);
+            });
+        }
+        else {
+            inserted = repo_.saveBatch(batch_);
+        }
+        if (inserted == -1) {
+            const size_t lost = batch_.size();
+            batch_.clear();
+            throw ImportWriteError("batch of " + std::to_string(lost) + " rows was rolled back");
+        }
+        for (auto& model : batch_) {
+            if (model.id != -1) {
+                keep(model);
+            }
+        }
+        batch_.clear();
+    }
+
+    // Flush the last partial batch and report throughput
+    ImportStats finish(const std::string& entity) {
+        try {
+            flush();
+        }
+        catch (const ImportWriteError& e) {
+            // finish() also runs from the readers' error handlers, where it must not throw
+            spdlog::error("Import stopped: {}", e.what());
+        }
+        stats_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+        spdlog::info("Imported {} of {} {} rows in {:.2f}s ({:.0f} rows/sec, {} mode)",
+            stats_.imported, stats_.rows, entity, stats_.seconds, stats_.rowsPerSecond(),
+            options_.enabled ? "bulk" : "row-by-row");
+        return stats_;
+    }
+};
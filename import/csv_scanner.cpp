@@ -0,0 +1,138 @@
+#include "csv_scanner.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CSV_SCANNER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CSV_TARGET_AVX2 __attribute__((target("avx2")))
+#define CSV_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define CSV_TARGET_AVX2
+#define CSV_TARGET_SSE2
+#endif
+
+namespace {
+    inline bool isStructural(char c) {
+        return c == ',' || c == '"' || c == '\n' || c == '\r';
+    }
+
+    inline unsigned countTrailingZeros(unsigned mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+#ifdef CSV_SCANNER_X86
+    // Classify 32 bytes at a time: one compare per structural character,
+    // OR the results into a bitmask and jump to its lowest set bit
+    CSV_TARGET_AVX2 const char* findStructuralAVX2(const char* p, const char* end) {
+        const __m256i comma = _mm256_set1_epi8(',');
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i newline = _mm256_set1_epi8('\n');
+        const __m256i carriage = _mm256_set1_epi8('\r');
+        for (; end - p >= 32; p += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i hits = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, comma), _mm256_cmpeq_epi8(block, quote)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, carriage)));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+            if (mask != 0) {
+                return p + countTrailingZeros(mask);
+            }
+        }
+        return findStructuralScalar(p, end);
+    }
+
+    CSV_TARGET_SSE2 const char* findStructuralSSE2(const char* p, const char* end) {
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i carriage = _mm_set1_epi8('\r');
+        for (; end - p >= 16; p += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i hits = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, comma), _mm_cmpeq_epi8(block, quote)),
+                _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, carriage)));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (mask != 0) {
+                return p + countTrailingZeros(mask);
+            }
+        }
+        return findStructuralScalar(p, end);
+    }
+
+    bool cpuHasAVX2() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) return false;
+        // The OS must save the YMM registers on context switches
+        if ((_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    bool cpuHasSSE2() {
+#if defined(_M_X64) || defined(__x86_64__)
+        return true;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+#endif
+    }
+#endif
+
+    using ScanFunction = const char* (*)(const char*, const char*);
+
+    struct Scanner {
+        ScanFunction scan;
+        std::string_view name;
+    };
+
+    Scanner selectScanner() {
+#ifdef CSV_SCANNER_X86
+        if (cpuHasAVX2()) return { findStructuralAVX2, "avx2" };
+        if (cpuHasSSE2()) return { findStructuralSSE2, "sse2" };
+#endif
+        return { findStructuralScalar, "scalar" };
+    }
+
+    const Scanner& scanner() {
+        static const Scanner selected = selectScanner();
+        return selected;
+    }
+}
+
+const char* findStructuralScalar(const char* begin, const char* end) {
+    while (begin < end && !isStructural(*begin)) ++begin;
+    return begin;
+}
+
+const char* findStructural(const char* begin, const char* end) {
+    return scanner().scan(begin, end);
+}
+
+std::string_view structuralScannerName() {
+    return scanner().name;
+}
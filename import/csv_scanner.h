@@ -0,0 +1,13 @@
+#pragma once
+#include <string_view>
+
+// Returns the first ',', '"', '\n' or '\r' in [begin, end), or end.
+// Uses AVX2 or SSE2 when the CPU supports them (checked once at runtime)
+// and falls back to a scalar loop otherwise.
+const char* findStructural(const char* begin, const char* end);
+
+// Portable reference implementation
+const char* findStructuralScalar(const char* begin, const char* end);
+
+// Name of the implementation picked by the runtime dispatch
+std::string_view structuralScannerName();
@@ -0,0 +1,243 @@
+#include "csv_tokenizer.h"
+#include "csv_scanner.h"
+#include <spdlog/spdlog.h>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    bool isBlank(char c) {
+        return c == ' ' || c == '\t';
+    }
+
+    std::string_view trimView(std::string_view value) {
+        size_t first = value.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos) return {};
+        size_t last = value.find_last_not_of(" \t\r\n");
+        return value.substr(first, last - first + 1);
+    }
+}
+
+CSVTokenizer::CSVTokenizer(std::string_view data)
+    : begin_(data.data()), pos_(data.data()), end_(data.data() + data.size()) {
+    // Skip UTF-8 BOM if present
+    if (data.size() >= 3 && data.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        pos_ += 3;
+    }
+    spdlog::debug("CSV tokenizer uses the {} structural scanner", structuralScannerName());
+}
+
+std::string& CSVTokenizer::scratch() {
+    if (scratch_used_ == scratch_.size()) {
+        scratch_.emplace_back();
+    }
+    std::string& buffer = scratch_[scratch_used_++];
+    buffer.clear();
+    return buffer;
+}
+
+std::string_view CSVTokenizer::quotedField() {
+    // pos_ is just past the opening quote
+    const char* start = pos_;
+    // The closing quote must come within max_quoted_field_size bytes
+    const char* limit = end_ - pos_ > static_cast<std::ptrdiff_t>(max_quoted_field_size)
+        ? pos_ + max_quoted_field_size + 1 : end_;
+    std::string* unescaped = nullptr;
+    while (true) {
+        const char* quote = pos_ < limit
+            ? static_cast<const char*>(std::memchr(pos_, '"', limit - pos_)) : nullptr;
+        if (quote == nullptr) {
+            if (limit < end_) {
+                throw CSVFormatError("quoted field is longer than " + std::to_string(max_quoted_field_size) + " bytes");
+            }
+            throw CSVFormatError("quoted field is not closed before the end of the input");
+        }
+        if (quote + 1 < end_ && quote[1] == '"') {
+            // Escaped quote: copy up to and including one quote, skip the other
+            if (unescaped == nullptr) unescaped = &scratch();
+            unescaped->append(start, quote + 1);
+            pos_ = quote + 2;
+            start = pos_;
+            continue;
+        }
+        pos_ = quote + 1;
+        std::string_view value;
+        if (unescaped == nullptr) {
+            value = std::string_view(start, quote - start);
+        }
+        else {
+            unescaped->append(start, quote);
+            value = *unescaped;
+        }
+        // As the old parser did, text between the closing quote and the
+        // separator is appended and the whole field is trimmed
+        const char* tail = pos_;
+        skipToSeparator();
+        std::string_view rest(tail, pos_ - tail);
+        if (trimView(rest).empty()) return trimView(value);
+        std::string& joined = scratch();
+        joined.append(value);
+        joined.append(rest);
+        return trimView(joined);
+    }
+}
+
+std::string_view CSVTokenizer::unquotedField() {
+    const char* start = pos_;
+    skipToSeparator();
+    return trimView(std::string_view(start, pos_ - start));
+}
+
+void CSVTokenizer::skipToSeparator() {
+    // Stray quotes inside an unquoted field are kept as ordinary characters
+    while ((pos_ = findStructural(pos_, end_)) < end_ && *pos_ == '"') {
+        ++pos_;
+    }
+}
+
+bool CSVTokenizer::next() {
+    fields_.clear();
+    scratch_used_ = 0;
+    // Skip empty lines
+    while (pos_ < end_ && (*pos_ == '\n' || *pos_ == '\r')) ++pos_;
+    if (pos_ >= end_) {
+        return false;
+    }
+    record_start_ = pos_;
+    while (true) {
+        while (pos_ < end_ && isBlank(*pos_)) ++pos_;
+        if (pos_ < end_ && *pos_ == '"') {
+            ++pos_;
+            fields_.push_back(quotedField());
+        }
+        else {
+            fields_.push_back(unquotedField());
+        }
+        if (pos_ < end_ && *pos_ == ',') {
+            ++pos_;
+            continue;
+        }
+        // End of record: consume \n, \r\n or \r
+        if (pos_ < end_ && *pos_ == '\r') ++pos_;
+        if (pos_ < end_ && *pos_ == '\n') ++pos_;
+        return true;
+    }
+}
+
+size_t findRecordEnd(std::string_view data, size_t min_size, RecordScan* scan) {
+    // Walks fields the way CSVTokenizer::next does: a quote opens a quoted
+    // field only at the start of a field, "" inside it is an escaped quote,
+    // and any other quote is an ordinary character
+    const char* begin = data.data();
+    const char* end = begin + data.size();
+    const char* p = begin;
+    const char* record_start = begin;
+    // Content start of the quoted field being read
+    const char* quote_start = nullptr;
+    bool in_field = false;
+    if (scan != nullptr) {
+        p = begin + scan->position;
+        record_start = begin + scan->record_start;
+        if (scan->quote_start != std::string_view::npos) quote_start = begin + scan->quote_start;
+        in_field = scan->in_field;
+    }
+    auto stop = [&](const char* at) {
+        if (scan != nullptr) {
+            *scan = RecordScan{ static_cast<size_t>(record_start - begin), static_cast<size_t>(at - begin),
+                quote_start != nullptr ? static_cast<size_t>(quote_start - begin) : std::string_view::npos, in_field };
+        }
+        return std::string_view::npos;
+    };
+
+    while (true) {
+        if (quote_start != nullptr) {
+            const char* limit = end - quote_start > static_cast<std::ptrdiff_t>(max_quoted_field_size)
+                ? quote_start + max_quoted_field_size + 1 : end;
+            const char* quote = p < limit
+                ? static_cast<const char*>(std::memchr(p, '"', limit - p)) : nullptr;
+            if (quote == nullptr) {
+                if (limit == end) {
+                    // May still be closed by data that has not been read yet
+                    return stop(end);
+                }
+                // Too long: end the chunk before this record, or hand the
+                // tokenizer one byte past the limit to report it
+                return record_start > begin
+                    ? static_cast<size_t>(record_start - begin)
+                    : static_cast<size_t>(limit - begin) + 1;
+            }
+            if (quote + 1 == end) {
+                // Closing or the first half of "": decided by the next byte
+                return stop(quote);
+            }
+            if (quote[1] == '"') {
+                p = quote + 2;
+                continue;
+            }
+            p = quote + 1;
+            quote_start = nullptr;
+            in_field = true;
+        }
+        if (!in_field) {
+            while (p < end && isBlank(*p)) ++p;
+            if (p >= end) {
+                return stop(p);
+            }
+            if (*p == '"') {
+                quote_start = ++p;
+                continue;
+            }
+            in_field = true;
+        }
+        // Rest of the field, up to a separator or a line break
+        while ((p = findStructural(p, end)) < end && *p == '"') {
+            ++p;
+        }
+        if (p >= end) {
+            return stop(end);
+        }
+        in_field = false;
+        if (*p == ',') {
+            ++p;
+            continue;
+        }
+        // \n, \r\n or a lone \r ends the record, as in CSVTokenizer::next
+        const char* next = p + 1;
+        if (*p == '\r') {
+            if (next == end) {
+                // A lone \r or the first half of \r\n: decided by the next byte
+                return stop(p);
+            }
+            if (*next == '\n') ++next;
+        }
+        if (static_cast<size_t>(p - begin) >= min_size) {
+            return static_cast<size_t>(next - begin);
+        }
+        p = next;
+        record_start = p;
+    }
+}
+
+CSVHeader::CSVHeader(const std::vector<std::string_view>& fields) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        columns_.emplace(std::string(fields[i]), i);
+    }
+}
+
+size_t CSVHeader::at(std::string_view name) const {
+    auto it = columns_.find(name);
+    if (it == columns_.end()) {
+        throw std::out_of_range("Unknown CSV column: " + std::string(name));
+    }
+    return it->second;
+}
+
+int parseInt(std::string_view field) {
+    int value = 0;
+    auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (result.ec != std::errc() || result.ptr != field.data() + field.size() || field.empty()) {
+        throw std::invalid_argument("Invalid integer: " + std::string(field));
+    }
+    return value;
+}
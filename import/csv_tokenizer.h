@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+
+// Longest quoted field accepted. A longer one is taken for an opening quote
+// that was never closed, so a single stray quote cannot swallow the file.
+inline constexpr size_t max_quoted_field_size = 1 << 20;
+
+// Bytes of a record shown in log messages
+inline constexpr size_t max_logged_record_size = 200;
+
+// Malformed CSV that cannot be read past, e.g. an unterminated quoted field
+class CSVFormatError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Zero-copy CSV tokenizer over an in-memory buffer (usually a MappedFile).
+// Fields are string_views into the buffer; only quoted fields containing
+// escaped "" quotes are unescaped into a per-row scratch area. Quoted
+// fields may contain separators and line breaks. Surrounding whitespace
+// is trimmed and empty lines are skipped. A quoted field that is not
+// closed before the end of the buffer, or within max_quoted_field_size
+// bytes, throws CSVFormatError.
+class CSVTokenizer {
+private:
+    const char* begin_;
+    const char* pos_;
+    const char* end_;
+    const char* record_start_ = nullptr;
+    std::vector<std::string_view> fields_;
+    // deque keeps earlier buffers in place while a row grows
+    std::deque<std::string> scratch_;
+    size_t scratch_used_ = 0;
+
+    std::string_view quotedField();
+    std::string_view unquotedField();
+    void skipToSeparator();
+    std::string& scratch();
+
+public:
+    explicit CSVTokenizer(std::string_view data);
+
+    // Parses the next record; returns false at the end of the buffer
+    bool next();
+    const std::vector<std::string_view>& fields() const { return fields_; }
+    // Raw text of the last record, cut to max_logged_record_size bytes, for log messages
+    std::string_view record() const {
+        return std::string_view(record_start_, std::min<size_t>(pos_ - record_start_, max_logged_record_size));
+    }
+    // Byte offset where the next record starts
+    size_t offset() const { return static_cast<size_t>(pos_ - begin_); }
+};
+
+// Where a findRecordEnd call that found no record end stopped, so a scan
+// of the same data with more appended can continue from there
+struct RecordScan {
+    // Start of the record being read
+    size_t record_start = 0;
+    // Everything before this offset was scanned
+    size_t position = 0;
+    // Start of the quoted field position is in, npos outside quotes
+    size_t quote_start = std::string_view::npos;
+    // position is past the start of an unquoted field (or a closed quote)
+    bool in_field = false;
+};
+
+// Offset just past the first record end (\n, \r\n or a lone \r) outside
+// quoted fields at or after min_size, or npos if data holds no such record end. data must start on
+// a record boundary; quotes are read as CSVTokenizer reads them. A quoted
+// field running past max_quoted_field_size cannot end a record: the scan
+// then stops at the start of its record, or just past the limit when it
+// is in the first record, so the tokenizer reports it. With scan, the
+// search continues from and updates a previous scan's state.
+size_t findRecordEnd(std::string_view data, size_t min_size, RecordScan* scan = nullptr);
+
+// Header row mapped to column indexes once per file
+class CSVHeader {
+private:
+    std::map<std::string, size_t, std::less<>> columns_;
+
+public:
+    explicit CSVHeader(const std::vector<std::string_view>& fields);
+    bool contains(std::string_view name) const { return columns_.find(name) != columns_.end(); }
+    // Throws std::out_of_range for an unknown column
+    size_t at(std::string_view name) const;
+    size_t size() const { return columns_.size(); }
+};
+
+// std::stoi for a string_view field; throws std::invalid_argument on bad input
+int parseInt(std::string_view field);
@@ -0,0 +1,159 @@
+#include "decompressor.h"
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+#include <zstd.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    bool endsWith(std::string value, std::string_view suffix) {
+        std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+        return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    struct FileCloser {
+        void operator()(FILE* file) const { fclose(file); }
+    };
+    using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+    FilePtr openBinary(const std::string& path) {
+        FILE* file = nullptr;
+        if (fopen_s(&file, path.c_str(), "rb") != 0) {
+            return FilePtr();
+        }
+        return FilePtr(file);
+    }
+}
+
+Compression detectCompression(const std::string& path) {
+    if (endsWith(path, ".gz") || endsWith(path, ".gzip")) return Compression::Gzip;
+    if (endsWith(path, ".zst") || endsWith(path, ".zstd")) return Compression::Zstd;
+
+    // Renamed or extensionless feeds are recognized by their magic bytes
+    FilePtr file = openBinary(path);
+    if (!file) return Compression::None;
+    unsigned char magic[4] = {};
+    size_t read = fread(magic, 1, sizeof(magic), file.get());
+    if (read >= 2 && magic[0] == 0x1F && magic[1] == 0x8B) return Compression::Gzip;
+    if (read == 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD) return Compression::Zstd;
+    return Compression::None;
+}
+
+std::string_view compressionName(Compression compression) {
+    switch (compression) {
+        case Compression::Gzip: return "gzip";
+        case Compression::Zstd: return "zstd";
+        default: return "none";
+    }
+}
+
+DecompressingReader::DecompressingReader(const std::string& path, Compression compression,
+    size_t block_size, size_t queue_depth)
+    : blocks_(queue_depth) {
+    thread_ = std::thread(&DecompressingReader::run, this, path, compression, block_size > 0 ? block_size : 1);
+    spdlog::info("Decompressing {} ({}) on a background thread", path, compressionName(compression));
+}
+
+DecompressingReader::~DecompressingReader() {
+    // Unblocks the producer if the consumer stopped early
+    blocks_.close();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void DecompressingReader::run(std::string path, Compression compression, size_t block_size) {
+    try {
+        if (compression == Compression::Zstd) {
+            readZstd(path, block_size);
+        }
+        else {
+            // gzread passes uncompressed files through unchanged
+            readGzip(path, block_size);
+        }
+    }
+    catch (const std::exception& e) {
+        failed_ = true;
+        spdlog::error("Failed to decompress {}: {}", path, e.what());
+    }
+    blocks_.close();
+}
+
+void DecompressingReader::readGzip(const std::string& path, size_t block_size) {
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("cannot open file");
+    }
+    gzbuffer(file, 256 * 1024);
+    while (true) {
+        std::string block(block_size, '\0');
+        int read = gzread(file, block.data(), static_cast<unsigned>(block.size()));
+        if (read <= 0) {
+            // A truncated stream also ends with 0, but leaves Z_BUF_ERROR behind
+            int code = Z_OK;
+            std::string message = gzerror(file, &code);
+            if (code != Z_OK && code != Z_STREAM_END) {
+                gzclose(file);
+                throw std::runtime_error(code == Z_BUF_ERROR ? "truncated gzip stream: " + message : message);
+            }
+            break;
+        }
+        block.resize(static_cast<size_t>(read));
+        if (!blocks_.push(std::move(block))) break;
+    }
+    gzclose(file);
+}
+
+void DecompressingReader::readZstd(const std::string& path, size_t block_size) {
+    FilePtr file = openBinary(path);
+    if (!file) {
+        throw std::runtime_error("cannot open file");
+    }
+    std::unique_ptr<ZSTD_DStream, size_t (*)(ZSTD_DStream*)> stream(ZSTD_createDStream(), ZSTD_freeDStream);
+    if (!stream) {
+        throw std::runtime_error("cannot create zstd stream");
+    }
+    ZSTD_initDStream(stream.get());
+
+    std::vector<char> input(ZSTD_DStreamInSize());
+    std::string block;
+    block.reserve(block_size);
+    std::vector<char> output(ZSTD_DStreamOutSize());
+    size_t last_result = 0;
+    size_t read;
+    while ((read = fread(input.data(), 1, input.size(), file.get())) > 0) {
+        ZSTD_inBuffer in = { input.data(), read, 0 };
+        while (in.pos < in.size) {
+            ZSTD_outBuffer out = { output.data(), output.size(), 0 };
+            last_result = ZSTD_decompressStream(stream.get(), &out, &in);
+            if (ZSTD_isError(last_result)) {
+                throw std::runtime_error(ZSTD_getErrorName(last_result));
+            }
+            block.append(output.data(), out.pos);
+            if (block.size() >= block_size) {
+                if (!blocks_.push(std::move(block))) return;
+                block.clear();
+                block.reserve(block_size);
+            }
+        }
+    }
+    if (last_result != 0) {
+        throw std::runtime_error("truncated zstd frame");
+    }
+    if (!block.empty()) {
+        blocks_.push(std::move(block));
+    }
+}
+
+bool DecompressingReader::next(std::string& block) {
+    auto item = blocks_.pop();
+    if (!item) {
+        return false;
+    }
+    block = std::move(*item);
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "bounded_queue.h"
+
+enum class Compression {
+    None,
+    Gzip,
+    Zstd
+};
+
+// Codec of an input file: .gz/.zst extensions first, then the magic bytes
+Compression detectCompression(const std::string& path);
+std::string_view compressionName(Compression compression);
+
+// Decompresses a file on a background thread into blocks of roughly
+// block_size bytes. The bounded queue lets decompression run a few blocks
+// ahead of the parser without holding the whole file in memory.
+class DecompressingReader {
+private:
+    BoundedQueue<std::string> blocks_;
+    std::atomic<bool> failed_{ false };
+    std::thread thread_;
+
+    void run(std::string path, Compression compression, size_t block_size);
+    void readGzip(const std::string& path, size_t block_size);
+    void readZstd(const std::string& path, size_t block_size);
+
+public:
+    DecompressingReader(const std::string& path, Compression compression,
+        size_t block_size = 1 << 20, size_t queue_depth = 4);
+    ~DecompressingReader();
+    DecompressingReader(const DecompressingReader&) = delete;
+    DecompressingReader& operator=(const DecompressingReader&) = delete;
+
+    // Next decompressed block; false at the end of the input or after an error
+    bool next(std::string& block);
+    bool failed() const { return failed_; }
+};
@@ -4,13 +4,17 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/genre_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/genre.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class CSVGenreReader {
 private:
     GenreRepository& repo_;
     std::string csv_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    CSVGenreReader(const std::string& file, GenreRepository& repo);
+    CSVGenreReader(const std::string& file, GenreRepository& repo, const BulkImportOptions& options = {});
     std::vector<Genre> loadFromCSV();
+    const ImportStats& stats() const { return stats_; }
 };
\ No newline at end of file
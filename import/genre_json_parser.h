@@ -4,13 +4,19 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/genre_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/genre.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class JSONGenreReader {
 private:
     GenreRepository& repo_;
     std::string json_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    JSONGenreReader(const std::string& file, GenreRepository& repo);
+    JSONGenreReader(const std::string& file, GenreRepository& repo, const BulkImportOptions& options = {});
     std::vector<Genre> loadFromJSON();
+    // One JSON object per line, parsed on options.workers threads
+    std::vector<Genre> loadFromNDJSON();
+    const ImportStats& stats() const { return stats_; }
 };
\ No newline at end of file
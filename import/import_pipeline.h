@@ -0,0 +1,288 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include "C:/Users/kos22/CLionProjects/library/import/bounded_queue.h"
+#include "C:/Users/kos22/CLionProjects/library/import/record_source.h"
+#include "C:/Users/kos22/CLionProjects/library/import/csv_tokenizer.h"
+#include "C:/Users/kos22/CLionProjects/library/databases/import_position.h"
+
+// A record the import cannot read past. row is the record's number,
+// counting data rows from the first record read.
+class RecordError : public std::runtime_error {
+private:
+    size_t row_;
+    std::string reason_;
+
+public:
+    RecordError(size_t row, const std::string& reason)
+        : std::runtime_error("row " + std::to_string(row) + ": " + reason), row_(row), reason_(reason) {
+    }
+
+    size_t row() const { return row_; }
+    const std::string& reason() const { return reason_; }
+};
+
+// Receives a parsed model and the position after its record, relative to the chunk's source
+template <typename Model>
+using RowSink = std::function<void(Model&, const ImportPosition&)>;
+
+// Parses one chunk, hands every valid model to the sink and returns the
+// number of records read (valid or not). Throws RecordError, with the row
+// counted within the chunk, for input it cannot read past.
+template <typename Model>
+using ChunkParser = std::function<size_t(const RecordChunk&, const RowSink<Model>&)>;
+
+// Builds a model from the fields of one record; throws on invalid input
+template <typename Model>
+using CSVRowParser = std::function<Model(const std::vector<std::string_view>&)>;
+
+// Builds a model from one JSON object; throws on invalid input
+template <typename Model>
+using JSONItemParser = std::function<Model(const nlohmann::json&)>;
+
+// CSV records with at least columns fields
+template <typename Model>
+ChunkParser<Model> csvChunkParser(size_t columns, CSVRowParser<Model> parse) {
+    return [columns, parse](const RecordChunk& chunk, const RowSink<Model>& sink) {
+        CSVTokenizer tokenizer(chunk.data);
+        size_t records = 0;
+        try {
+            while (tokenizer.next()) {
+                ++records;
+                const auto& fields = tokenizer.fields();
+                spdlog::debug("Processing line: {}", tokenizer.record());
+                if (fields.size() < columns) {
+                    spdlog::warn("Invalid row, too few fields: {}", tokenizer.record());
+                    continue;
+                }
+                try {
+                    Model model = parse(fields);
+                    sink(model, ImportPosition{ chunk.offset + tokenizer.offset(), records });
+                }
+                catch (const ImportWriteError&) {
+                    // The sink may write the row; a failed write ends the import, not just this row
+                    throw;
+                }
+                catch (const std::exception& e) {
+                    spdlog::warn("Error parsing row: {}. Error: {}", tokenizer.record(), e.what());
+                }
+            }
+        }
+        catch (const CSVFormatError& e) {
+            // Everything after an unterminated quote would be misread
+            throw RecordError(records + 1, e.what());
+        }
+        return records;
+    };
+}
+
+// One JSON object per line; blank lines are skipped
+template <typename Model>
+ChunkParser<Model> jsonLinesParser(JSONItemParser<Model> parse) {
+    return [parse](const RecordChunk& chunk, const RowSink<Model>& sink) {
+        std::string_view data = chunk.data;
+        size_t records = 0;
+        size_t start = 0;
+        while (start < data.size()) {
+            size_t end = data.find('\n', start);
+            size_t next = end == std::string_view::npos ? data.size() : end + 1;
+            std::string_view line = data.substr(start, next - start);
+            start = next;
+            size_t last = line.find_last_not_of(" \t\r\n");
+            if (last == std::string_view::npos) continue;
+            line = line.substr(0, last + 1);
+            ++records;
+            try {
+                Model model = parse(nlohmann::json::parse(line.begin(), line.end()));
+                sink(model, ImportPosition{ chunk.offset + next, records });
+            }
+            catch (const ImportWriteError&) {
+                throw;
+            }
+            catch (const std::exception& e) {
+                spdlog::warn("Error parsing line: {}. Error: {}", line, e.what());
+            }
+        }
+        return records;
+    };
+}
+
+// Parallel parse/validate stage of the file imports.
+// A reader thread takes record-aligned chunks from the RecordSource, worker
+// threads parse them and construct (and so validate) the models, and the
+// calling thread is the single writer that hands the rows to a BatchWriter
+// in file order. All stages are connected by bounded queues, and the reader
+// stays at most a window of chunks ahead of the writer, so memory stays flat
+// even when one chunk is slow to parse. With one worker everything runs
+// inline on the calling thread. A RecordError stops the import after the
+// rows before it were written.
+template <typename Model>
+class ImportPipeline {
+private:
+    struct Chunk {
+        size_t sequence;
+        RecordChunk chunk;
+    };
+
+    struct ParsedChunk {
+        size_t sequence;
+        std::vector<Model> rows;
+        // Position after each row; rows are counted within the chunk
+        std::vector<ImportPosition> positions;
+        size_t records = 0;
+        // Set if the parser stopped early; rows holds the ones before it
+        std::exception_ptr error;
+    };
+
+    size_t workers_;
+    size_t queue_depth_;
+
+    // Rethrows a parser error with its row counted from the first record read
+    static void rethrowAt(const std::exception_ptr& error, size_t records_before) {
+        try {
+            std::rethrow_exception(error);
+        }
+        catch (const RecordError& e) {
+            throw RecordError(records_before + e.row(), e.reason());
+        }
+    }
+
+public:
+    ImportPipeline(size_t workers, size_t queue_depth)
+        : workers_(workers > 0 ? workers : 1), queue_depth_(queue_depth) {
+    }
+
+    // Imports the records left in source; writer needs add(Model&, const ImportPosition&)
+    // and receives positions relative to the first record read
+    template <typename Writer>
+    void run(RecordSource& source, const ChunkParser<Model>& parse, Writer& writer) {
+        if (workers_ == 1) {
+            RecordChunk chunk;
+            size_t records_before = 0;
+            while (source.next(chunk)) {
+                try {
+                    records_before += parse(chunk, [&](Model& model, ImportPosition position) {
+                        position.row += records_before;
+                        writer.add(model, position);
+                    });
+                }
+                catch (...) {
+                    rethrowAt(std::current_exception(), records_before);
+                }
+            }
+            return;
+        }
+
+        BoundedQueue<Chunk> chunks(queue_depth_);
+        BoundedQueue<ParsedChunk> parsed(queue_depth_);
+        std::atomic<size_t> running(workers_);
+        std::exception_ptr read_error;
+
+        // Chunks the reader may hand out beyond the last one written; this
+        // bounds the reorder buffer below, not just the queues
+        const size_t window = std::max(queue_depth_, workers_);
+        std::mutex window_mutex;
+        std::condition_variable window_cv;
+        size_t written = 0;
+        bool stopped = false;
+        auto stop = [&] {
+            std::lock_guard<std::mutex> lock(window_mutex);
+            stopped = true;
+            window_cv.notify_all();
+        };
+
+        std::thread reader([&] {
+            try {
+                RecordChunk chunk;
+                size_t sequence = 0;
+                while (source.next(chunk)) {
+                    {
+                        std::unique_lock<std::mutex> lock(window_mutex);
+                        window_cv.wait(lock, [&] { return stopped || sequence < written + window; });
+                        if (stopped) break;
+                    }
+                    if (!chunks.push(Chunk{ sequence++, chunk })) break;
+                }
+            }
+            catch (...) {
+                read_error = std::current_exception();
+            }
+            chunks.close();
+        });
+
+        std::vector<std::thread> workers;
+        workers.reserve(workers_);
+        for (size_t i = 0; i < workers_; ++i) {
+            workers.emplace_back([&] {
+                while (auto chunk = chunks.pop()) {
+                    ParsedChunk result{ chunk->sequence, {}, {}, 0, nullptr };
+                    try {
+                        result.records = parse(chunk->chunk, [&](Model& model, const ImportPosition& position) {
+                            result.rows.push_back(std::move(model));
+                            result.positions.push_back(position);
+                        });
+                    }
+                    catch (...) {
+                        result.error = std::current_exception();
+                    }
+                    if (!parsed.push(std::move(result))) break;
+                }
+                // The last worker to finish ends the writer loop
+                if (--running == 0) parsed.close();
+            });
+        }
+
+        // Chunks finish out of order; hold early ones back so rows are written in file order
+        std::map<size_t, ParsedChunk> pending;
+        size_t next_sequence = 0;
+        size_t records_before = 0;
+        try {
+            while (auto chunk = parsed.pop()) {
+                pending.emplace(chunk->sequence, std::move(*chunk));
+                for (auto it = pending.find(next_sequence); it != pending.end(); it = pending.find(++next_sequence)) {
+                    ParsedChunk& ready = it->second;
+                    for (size_t i = 0; i < ready.rows.size(); ++i) {
+                        ImportPosition position = ready.positions[i];
+                        position.row += records_before;
+                        writer.add(ready.rows[i], position);
+                    }
+                    if (ready.error) {
+                        rethrowAt(ready.error, records_before);
+                    }
+                    records_before += ready.records;
+                    pending.erase(it);
+                    std::lock_guard<std::mutex> lock(window_mutex);
+                    written = next_sequence + 1;
+                    window_cv.notify_all();
+                }
+            }
+        }
+        catch (...) {
+            stop();
+            chunks.close();
+            parsed.close();
+            reader.join();
+            for (auto& worker : workers) worker.join();
+            throw;
+        }
+
+        reader.join();
+        for (auto& worker : workers) worker.join();
+        if (read_error) {
+            std::rethrow_exception(read_error);
+        }
+        spdlog::debug("Import pipeline finished with {} workers", workers_);
+    }
+};
@@ -0,0 +1,42 @@
+#include "input_stream.h"
+
+DecompressingStreambuf::DecompressingStreambuf(const std::string& path, Compression compression)
+    : reader_(path, compression) {
+}
+
+DecompressingStreambuf::int_type DecompressingStreambuf::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    if (!reader_.next(block_) || block_.empty()) {
+        return traits_type::eof();
+    }
+    setg(block_.data(), block_.data(), block_.data() + block_.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+ImportInputStream::ImportInputStream(const std::string& path) : std::istream(nullptr) {
+    Compression compression = detectCompression(path);
+    if (compression == Compression::None) {
+        auto file = std::make_unique<std::filebuf>();
+        open_ = file->open(path, std::ios::in | std::ios::binary) != nullptr;
+        buffer_ = std::move(file);
+    }
+    else {
+        std::ifstream probe(path, std::ios::binary);
+        open_ = probe.is_open();
+        if (open_) {
+            buffer_ = std::make_unique<DecompressingStreambuf>(path, compression);
+        }
+    }
+    rdbuf(buffer_.get());
+    if (!open_) {
+        setstate(std::ios::failbit);
+    }
+}
+
+void ImportInputStream::close() {
+    rdbuf(nullptr);
+    buffer_.reset();
+    open_ = false;
+}
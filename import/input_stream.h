@@ -0,0 +1,34 @@
+#pragma once
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include "decompressor.h"
+
+// std::streambuf over the blocks of a DecompressingReader
+class DecompressingStreambuf : public std::streambuf {
+private:
+    DecompressingReader reader_;
+    std::string block_;
+
+protected:
+    int_type underflow() override;
+
+public:
+    DecompressingStreambuf(const std::string& path, Compression compression);
+};
+
+// Input file for the JSON readers: a plain ifstream, or a stream that is
+// decompressed on a background thread for gzip and zstd files
+class ImportInputStream : public std::istream {
+private:
+    std::unique_ptr<std::streambuf> buffer_;
+    bool open_ = false;
+
+public:
+    explicit ImportInputStream(const std::string& path);
+    bool is_open() const { return open_; }
+    // Releases the file and stops a running decompression thread
+    void close();
+};
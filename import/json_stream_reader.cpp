@@ -0,0 +1,98 @@
+#include "json_stream_reader.h"
+#include <vector>
+#include <string>
+
+namespace {
+    using json = nlohmann::json;
+
+    class ArrayElementHandler : public nlohmann::json_sax<json> {
+    private:
+        const JSONArrayStream::Callback& on_item_;
+        json current_;
+        std::vector<json*> stack_;
+        json* member_ = nullptr;
+        bool in_array_ = false;
+
+        bool value(json&& v) {
+            if (!in_array_) {
+                return false; // top-level scalar
+            }
+            if (stack_.empty()) {
+                on_item_(v);
+                return true;
+            }
+            json* parent = stack_.back();
+            if (parent->is_array()) {
+                parent->push_back(std::move(v));
+            }
+            else {
+                *member_ = std::move(v);
+            }
+            return true;
+        }
+
+        bool open(json&& container) {
+            if (!in_array_) {
+                if (!container.is_array()) {
+                    return false; // top-level object
+                }
+                in_array_ = true;
+                return true;
+            }
+            if (stack_.empty()) {
+                current_ = std::move(container);
+                stack_.push_back(&current_);
+                return true;
+            }
+            json* parent = stack_.back();
+            if (parent->is_array()) {
+                parent->push_back(std::move(container));
+                stack_.push_back(&parent->back());
+            }
+            else {
+                *member_ = std::move(container);
+                stack_.push_back(member_);
+            }
+            return true;
+        }
+
+        bool close() {
+            if (stack_.empty()) {
+                return true; // end of the top-level array
+            }
+            stack_.pop_back();
+            if (stack_.empty()) {
+                on_item_(current_);
+                current_ = nullptr;
+            }
+            return true;
+        }
+
+    public:
+        explicit ArrayElementHandler(const JSONArrayStream::Callback& on_item) : on_item_(on_item) {}
+
+        bool null() override { return value(nullptr); }
+        bool boolean(bool val) override { return value(val); }
+        bool number_integer(number_integer_t val) override { return value(val); }
+        bool number_unsigned(number_unsigned_t val) override { return value(val); }
+        bool number_float(number_float_t val, const string_t&) override { return value(val); }
+        bool string(string_t& val) override { return value(std::move(val)); }
+        bool binary(binary_t& val) override { return value(json::binary(std::move(val))); }
+        bool start_object(std::size_t) override { return open(json::object()); }
+        bool key(string_t& val) override {
+            member_ = &(*stack_.back())[val];
+            return true;
+        }
+        bool end_object() override { return close(); }
+        bool start_array(std::size_t) override { return open(json::array()); }
+        bool end_array() override { return close(); }
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+            throw std::runtime_error(ex.what());
+        }
+    };
+}
+
+bool JSONArrayStream::parse(std::istream& input, const Callback& on_item) {
+    ArrayElementHandler handler(on_item);
+    return json::sax_parse(input, &handler);
+}
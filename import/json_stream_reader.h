@@ -0,0 +1,16 @@
+#pragma once
+#include <istream>
+#include <functional>
+#include <nlohmann/json.hpp>
+
+// Incremental reader for a top-level JSON array built on nlohmann's SAX
+// interface. Only the element currently being parsed is kept in memory;
+// it is handed to the callback as soon as its closing bracket is read.
+class JSONArrayStream {
+public:
+    using Callback = std::function<void(const nlohmann::json& item)>;
+
+    // Returns false if the document is not an array; syntax errors and
+    // exceptions thrown by the callback propagate to the caller
+    static bool parse(std::istream& input, const Callback& on_item);
+};
@@ -4,13 +4,17 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/publisher_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/publisher.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class CSVPublisherReader {
 private:
     PublisherRepository& repo_;
     std::string csv_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    CSVPublisherReader(const std::string& file, PublisherRepository& repo);
+    CSVPublisherReader(const std::string& file, PublisherRepository& repo, const BulkImportOptions& options = {});
     std::vector<Publisher> loadFromCSV();
+    const ImportStats& stats() const { return stats_; }
 }; 
\ No newline at end of file
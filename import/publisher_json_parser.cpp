@@ -1,89 +1,134 @@
 #include "publisher_json_parser.h"
+#include "json_stream_reader.h"
+#include "input_stream.h"
+#include "import_pipeline.h"
+#include "record_source.h"
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
-#include <fstream>
 #include <set>
 #include <algorithm>
 
-JSONPublisherReader::JSONPublisherReader(const std::string& file, PublisherRepository& repo)
-    : repo_(repo), json_file_(file) {
+namespace {
+    const std::set<std::string> required_fields = { "Title", "Address", "Phone", "Mail" };
+
+    // Comma-separated list of the required fields item lacks; empty if none
+    std::string missingFields(const nlohmann::json& item) {
+        std::string missing;
+        for (const auto& field : required_fields) {
+            if (!item.contains(field)) {
+                missing += field + ", ";
+            }
+        }
+        if (!missing.empty()) missing = missing.substr(0, missing.size() - 2);
+        return missing;
+    }
+
+    Publisher publisherFromJSON(const nlohmann::json& item) {
+        return Publisher(
+            item["Title"].get<std::string>(),
+            item["Address"].get<std::string>(),
+            item["Phone"].get<std::string>(),
+            item["Mail"].get<std::string>()
+        );
+    }
+}
+
+JSONPublisherReader::JSONPublisherReader(const std::string& file, PublisherRepository& repo, const BulkImportOptions& options)
+    : repo_(repo), json_file_(file), options_(options) {
     spdlog::info("JSONPublisherReader initialized with file: {}", json_file_);
 }
 
 std::vector<Publisher> JSONPublisherReader::loadFromJSON() {
     spdlog::info("Loading JSON from file: {}", json_file_);
     std::vector<Publisher> publishers;
+    BatchWriter<Publisher, PublisherRepository> writer(repo_, options_, publishers);
     try {
-        std::ifstream file(json_file_);
+        // .gz/.zst files are decompressed on a background thread
+        ImportInputStream file(json_file_);
         if (!file.is_open()) {
             spdlog::error("Failed to open JSON file: {}", json_file_);
             return publishers;
         }
 
-        nlohmann::json json_data;
-        file >> json_data;
-        file.close();
-
-        // Check if json_data is an array
-        if (!json_data.is_array()) {
-            spdlog::error("JSON is not an array");
-            return publishers;
-        }
-
-        std::set<std::string> required_fields = { "Title", "Address", "Phone", "Mail" };
         int row_number = 1;
 
-        for (const auto& item : json_data) {
+        // Rows are validated and saved as soon as each array element is parsed
+        bool is_array = JSONArrayStream::parse(file, [&](const nlohmann::json& item) {
             spdlog::debug("Processing row: {}", row_number);
 
-            // Check for required fields
-            std::set<std::string> item_keys;
-            for (auto it = item.begin(); it != item.end(); ++it) {
-                item_keys.insert(it.key());
-            }
-
-            std::set<std::string> missing_fields;
-            std::set_difference(
-                required_fields.begin(), required_fields.end(),
-                item_keys.begin(), item_keys.end(),
-                std::inserter(missing_fields, missing_fields.begin())
-            );
-            if (!missing_fields.empty()) {
-                std::string missing;
-                for (const auto& field : missing_fields) {
-                    missing += field + ", ";
-                }
-                if (!missing.empty()) missing = missing.substr(0, missing.size() - 2);
+            std::string missing = missingFields(item);
+            if (!missing.empty()) {
                 spdlog::warn("Missing fields in row {}: {}", row_number, missing);
                 throw std::runtime_error("JSON does not contain required headers");
             }
 
             try {
-                Publisher publisher(
-                    item["Title"].get<std::string>(),
-                    item["Address"].get<std::string>(),
-                    item["Phone"].get<std::string>(),
-                    item["Mail"].get<std::string>()
-                );
-                if (repo_.save(publisher) != -1) {
-                    publishers.push_back(publisher);
-                } else {
-                    spdlog::warn("Publisher already exists in row {}: {}", row_number, item["Name"].get<std::string>());
+                Publisher publisher = publisherFromJSON(item);
+                if (!writer.add(publisher)) {
+                    spdlog::warn("Publisher already exists in row {}: {}", row_number, item["Title"].get<std::string>());
                 }
             }
+            catch (const ImportWriteError&) {
+                throw;
+            }
             catch (const std::exception& e) {
                 spdlog::warn("Error parsing row {}: {}", row_number, e.what());
             }
             ++row_number;
+        });
+        file.close();
+
+        if (!is_array) {
+            spdlog::error("JSON is not an array");
         }
 
-        spdlog::info("Loaded {} publishers from JSON", publishers.size());
+        stats_ = writer.finish("publisher");
+        spdlog::info("Loaded {} publishers from JSON", stats_.imported);
         return publishers;
     }
     catch (const std::exception& e) {
         spdlog::error("Error reading JSON: {}", e.what());
+        stats_ = writer.finish("publisher");
         return publishers;
     }
-}
\ No newline at end of file
+}
+
+std::vector<Publisher> JSONPublisherReader::loadFromNDJSON() {
+    spdlog::info("Loading NDJSON from file: {}", json_file_);
+    std::vector<Publisher> publishers;
+    BatchWriter<Publisher, PublisherRepository> writer(repo_, options_, publishers);
+    try {
+        RecordSource source(json_file_, RecordFormat::Lines, options_.chunk_size);
+        if (!source.isOpen()) {
+            spdlog::error("Failed to open NDJSON file: {}", json_file_);
+            return publishers;
+        }
+
+        // Rows committed by an interrupted import are skipped without parsing
+        if (source.seekable()) {
+            source.seek(writer.resume(json_file_, source.recordsOffset(), source.size()));
+        }
+
+        // Lines are independent, so byte ranges split at newlines are parsed on worker threads
+        ImportPipeline<Publisher> pipeline(options_.workers, options_.queue_depth);
+        pipeline.run(source, jsonLinesParser<Publisher>([](const nlohmann::json& item) {
+            std::string missing = missingFields(item);
+            if (!missing.empty()) {
+                throw std::runtime_error("Missing fields: " + missing);
+            }
+            return publisherFromJSON(item);
+        }), writer);
+
+        writer.complete();
+        stats_ = writer.finish("publisher");
+        spdlog::info("Loaded {} publishers from NDJSON", stats_.imported);
+        return publishers;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error reading NDJSON: {}", e.what());
+        stats_ = writer.finish("publisher");
+        return publishers;
+    }
+}
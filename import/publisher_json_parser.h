@@ -3,13 +3,19 @@
 #include <vector>
 #include "C:/Users/kos22/CLionProjects/library/databases/publisher_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/models/publisher.h"
+#include "C:/Users/kos22/CLionProjects/library/import/bulk_import.h"
 
 class JSONPublisherReader {
 private:
     PublisherRepository& repo_;
     std::string json_file_;
+    BulkImportOptions options_;
+    ImportStats stats_;
 
 public:
-    JSONPublisherReader(const std::string& file, PublisherRepository& repo);
+    JSONPublisherReader(const std::string& file, PublisherRepository& repo, const BulkImportOptions& options = {});
     std::vector<Publisher> loadFromJSON();
+    // One JSON object per line, parsed on options.workers threads
+    std::vector<Publisher> loadFromNDJSON();
+    const ImportStats& stats() const { return stats_; }
 };
\ No newline at end of file
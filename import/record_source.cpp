@@ -0,0 +1,132 @@
+#include "record_source.h"
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    size_t bomLength(std::string_view data) {
+        return data.size() >= 3 && data.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    }
+
+    // BOM and blank lines before the header record
+    size_t headerStart(std::string_view data) {
+        size_t start = bomLength(data);
+        while (start < data.size() && (data[start] == '\n' || data[start] == '\r')) ++start;
+        return start;
+    }
+}
+
+RecordSource::RecordSource(const std::string& path, RecordFormat format, size_t chunk_size)
+    : format_(format), chunk_size_(chunk_size > 0 ? chunk_size : 1) {
+    Compression compression = detectCompression(path);
+    if (compression == Compression::None) {
+        mapped_ = std::make_unique<MappedFile>(path);
+        open_ = mapped_->isOpen();
+        if (!open_) return;
+        size_t header_end = 0;
+        readHeader(mapped_->view(), header_end);
+        records_offset_ = header_end;
+        position_ = header_end;
+        return;
+    }
+
+    if (!std::ifstream(path, std::ios::binary).is_open()) {
+        return;
+    }
+    open_ = true;
+    reader_ = std::make_unique<DecompressingReader>(path, compression, chunk_size_);
+    // Read blocks until the header record (or, for lines, a possible BOM) is complete
+    while (true) {
+        if (format_ == RecordFormat::Lines && pending_.size() >= 3) break;
+        size_t start = headerStart(pending_);
+        if (start < pending_.size() && recordEnd(std::string_view(pending_).substr(start), 0) != std::string_view::npos) break;
+        if (!fill()) break;
+    }
+    size_t header_end = 0;
+    readHeader(pending_, header_end);
+    header_storage_.assign(header_.data(), header_.size());
+    header_ = header_storage_;
+    pending_.erase(0, header_end);
+    records_offset_ = header_end;
+}
+
+void RecordSource::readHeader(std::string_view data, size_t& header_end) {
+    if (format_ == RecordFormat::Lines) {
+        // No header, only the BOM is skipped
+        header_end = bomLength(data);
+        header_ = std::string_view();
+        return;
+    }
+    size_t start = headerStart(data);
+    size_t end = recordEnd(data.substr(start), 0);
+    header_end = end == std::string_view::npos ? data.size() : start + end;
+    header_ = data.substr(start, header_end - start);
+}
+
+size_t RecordSource::recordEnd(std::string_view data, size_t min_size, RecordScan* scan) const {
+    if (format_ == RecordFormat::CSV) {
+        return findRecordEnd(data, min_size, scan);
+    }
+    // JSON strings cannot contain raw line breaks, so any newline ends a record
+    const size_t start = std::max(min_size, scan != nullptr ? scan->position : 0);
+    if (start >= data.size()) return std::string_view::npos;
+    const void* newline = std::memchr(data.data() + start, '\n', data.size() - start);
+    if (newline == nullptr) {
+        if (scan != nullptr) scan->position = data.size();
+        return std::string_view::npos;
+    }
+    return static_cast<size_t>(static_cast<const char*>(newline) - data.data()) + 1;
+}
+
+bool RecordSource::fill() {
+    std::string block;
+    if (!reader_->next(block)) {
+        if (reader_->failed()) {
+            throw std::runtime_error("Failed to decompress input");
+        }
+        return false;
+    }
+    pending_.append(block);
+    return true;
+}
+
+void RecordSource::seek(size_t offset) {
+    if (!mapped_ || offset > mapped_->size()) {
+        throw std::logic_error("Record source is not seekable to this offset");
+    }
+    position_ = offset;
+    consumed_ = 0;
+}
+
+bool RecordSource::next(RecordChunk& chunk) {
+    if (mapped_) {
+        std::string_view rest = mapped_->view().substr(position_);
+        if (rest.empty()) return false;
+        size_t end = recordEnd(rest, chunk_size_);
+        if (end == std::string_view::npos) end = rest.size();
+        chunk.storage.reset();
+        chunk.data = rest.substr(0, end);
+        chunk.offset = consumed_;
+        position_ += end;
+        consumed_ += end;
+        return true;
+    }
+
+    // Each new block is scanned from where the previous search stopped, so
+    // a record spanning many blocks is not rescanned from the start
+    size_t end = std::string_view::npos;
+    while ((end = recordEnd(pending_, chunk_size_, &scan_)) == std::string_view::npos) {
+        if (!fill()) break;
+    }
+    if (pending_.empty()) return false;
+    if (end == std::string_view::npos) end = pending_.size();
+    auto storage = std::make_shared<std::string>(pending_, 0, end);
+    pending_.erase(0, end);
+    scan_ = RecordScan();
+    chunk.data = *storage;
+    chunk.storage = std::move(storage);
+    chunk.offset = consumed_;
+    consumed_ += end;
+    return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include "mapped_file.h"
+#include "decompressor.h"
+#include "csv_tokenizer.h"
+
+// How records are delimited in an input file
+enum class RecordFormat {
+    // CSV with a header row; quoted fields may span lines
+    CSV,
+    // One record per line, e.g. NDJSON
+    Lines
+};
+
+// Piece of an input file made of whole records
+struct RecordChunk {
+    // Owns decompressed data; empty for memory-mapped files
+    std::shared_ptr<std::string> storage;
+    std::string_view data;
+    // Byte offset relative to the first record read from the source
+    size_t offset = 0;
+};
+
+// Record-aligned chunks of an import file. Plain files are memory-mapped
+// and cut in place; gzip and zstd files are decompressed on a background
+// thread and cut into chunks as the blocks arrive. A CSV header record is
+// read up front; the UTF-8 BOM is dropped in both formats.
+class RecordSource {
+private:
+    RecordFormat format_;
+    size_t chunk_size_;
+    std::unique_ptr<MappedFile> mapped_;
+    std::unique_ptr<DecompressingReader> reader_;
+    std::string header_storage_;
+    std::string_view header_;
+    size_t records_offset_ = 0;
+    // Mapped file: offset of the next chunk
+    size_t position_ = 0;
+    // Decompressed input not handed out yet
+    std::string pending_;
+    // How far pending_ was searched for a record end without finding one
+    RecordScan scan_;
+    size_t consumed_ = 0;
+    bool open_ = false;
+
+    bool fill();
+    void readHeader(std::string_view data, size_t& header_end);
+    // Record end at or after min_size; with scan, the search continues where it stopped
+    size_t recordEnd(std::string_view data, size_t min_size, RecordScan* scan = nullptr) const;
+
+public:
+    RecordSource(const std::string& path, RecordFormat format, size_t chunk_size = 1 << 20);
+
+    bool isOpen() const { return open_; }
+    // Raw text of the CSV header record; empty for an empty file and for lines
+    std::string_view header() const { return header_; }
+    // Byte offset of the first data record
+    size_t recordsOffset() const { return records_offset_; }
+    // Only mapped files can be read from an arbitrary offset
+    bool seekable() const { return mapped_ != nullptr; }
+    size_t size() const { return mapped_ ? mapped_->size() : 0; }
+    // Continues at offset, which must be a record boundary (seekable sources only)
+    void seek(size_t offset);
+
+    // Returns false at the end of the input; throws if decompression failed
+    bool next(RecordChunk& chunk);
+};
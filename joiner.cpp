@@ -63,47 +63,45 @@ namespace {
     }
 }
 
-Joiner::Joiner(const std::string& db_path) : db_path_(db_path) {
-    spdlog::info("Joiner initialized with database: {}", db_path_);
+Joiner::Joiner(ConnectionPool& pool) : pool_(pool) {
+    spdlog::info("Joiner initialized with database: {}", pool_.path());
 }
 
 int Joiner::join(const std::string& table_title) {
     spdlog::info("Executing JOIN query for table: {}", table_title);
     try {
-        SQLite::Database db(db_path_, SQLite::OPEN_READONLY);
-        SQLite::Statement query(db, "");
+        std::string query_str;
         std::vector<std::string> headers;
         std::vector<std::vector<std::string>> table_data;
 
         if (table_title == "author") {
-            query = SQLite::Statement(db,
-                "SELECT book.title, book.year, book.genre_id, book.pages, book.publisher_id, "
+            query_str = "SELECT book.title, book.year, book.genre_id, book.pages, book.publisher_id, "
                 "author.full_name, author.date_of_birth, author.date_of_death "
-                "FROM book JOIN author ON book.author_id = author.id");
+                "FROM book JOIN author ON book.author_id = author.id";
             headers = { "title", "year", "genre", "pages", "publisher",
                        "author", "date_of_birth", "date_of_death" };
         }
         else if (table_title == "publisher") {
-            query = SQLite::Statement(db,
-                "SELECT book.title, book.author_id, book.year, book.genre_id, book.pages, "
+            query_str = "SELECT book.title, book.author_id, book.year, book.genre_id, book.pages, "
                 "publisher.name, publisher.address, publisher.phone, publisher.mail "
-                "FROM book JOIN publisher ON book.publisher_id = publisher.id");
+                "FROM book JOIN publisher ON book.publisher_id = publisher.id";
             headers = { "title", "author", "year", "genre", "pages",
                        "publisher", "address", "phone", "mail" };
         }
         else {
-            query = SQLite::Statement(db,
-                "SELECT book.title, book.author_id, book.year, book.pages, book.publisher_id, "
+            query_str = "SELECT book.title, book.author_id, book.year, book.pages, book.publisher_id, "
                 "genre.title, genre.description "
-                "FROM book JOIN genre ON book.genre_id = genre.id");
+                "FROM book JOIN genre ON book.genre_id = genre.id";
             headers = { "title", "author", "year", "pages", "publisher",
                        "genre", "description" };
         }
 
-        while (query.executeStep()) {
+        auto conn = pool_.reader();
+        auto query = conn->statements().get(query_str);
+        while (query->executeStep()) {
             std::vector<std::string> row;
-            for (int i = 0; i < query.getColumnCount(); ++i) {
-                std::string value = query.getColumn(i).isNull() ? "" : query.getColumn(i).getString();
+            for (int i = 0; i < query->getColumnCount(); ++i) {
+                std::string value = query->getColumn(i).isNull() ? "" : query->getColumn(i).getString();
                 row.push_back(value);
             }
             table_data.push_back(row);
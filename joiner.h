@@ -2,12 +2,13 @@
 #include <string>
 #include <vector>
 #include <SQLiteCpp/SQLiteCpp.h>
+#include "C:/Users/kos22/CLionProjects/library/databases/connection_pool.h"
 
 class Joiner {
 private:
-    std::string db_path_;
+    ConnectionPool& pool_;
 
 public:
-    Joiner(const std::string& db_path = "library.db");
+    Joiner(ConnectionPool& pool);
     int join(const std::string& table_title);
 };
\ No newline at end of file
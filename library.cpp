@@ -6,7 +6,139 @@
 #include <sys/stat.h>
 #include <string>
 #include <cstdio>
+#include <thread>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <sstream>
+#include <cctype>
+#include <functional>
+
+
+namespace {
+    // Menu choices used by load() for each entity
+    const std::map<std::string, std::string> entity_choices = {
+        {"book", "1"}, {"author", "2"}, {"publisher", "3"}, {"genre", "4"}
+    };
+
+    std::string entityName(const std::string& choice) {
+        for (const auto& entity : entity_choices) {
+            if (entity.second == choice) return entity.first;
+        }
+        return "record";
+    }
+
+    // Maps "authors", "Author" or a file name such as "authors_001.csv" to a menu choice
+    std::string entityChoice(std::string name) {
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        for (const auto& entity : entity_choices) {
+            if (name.rfind(entity.first, 0) == 0) return entity.second;
+        }
+        return "";
+    }
+
+    // Bound of a range search: an integer, or dd.mm.yyyy as yyyymmdd for author dates
+    long long rangeBound(const std::string& choice, const std::string& field, const std::string& text) {
+        if (choice == "2" && (field == "birth_date" || field == "death_date")) {
+            validation::CompactDate date = validation::tryParseDate(text);
+            if (date == 0) {
+                throw std::invalid_argument("Invalid date '" + text + "', expected dd.mm.yyyy");
+            }
+            return date;
+        }
+        return std::stoll(text);
+    }
 
+    double secondsSince(std::chrono::steady_clock::time_point started) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    // Rows per page for the listing menus; 0 shows everything at once
+    size_t askPageSize() {
+        std::cout << "Rows per page (Enter for all): ";
+        std::string answer;
+        std::getline(std::cin, answer);
+        try {
+            return answer.empty() ? 0 : std::stoul(answer);
+        }
+        catch (const std::exception&) {
+            std::cout << "Invalid number, showing all rows\n";
+            return 0;
+        }
+    }
+
+    // Shows pages until the last one or until the user stops
+    void pageThrough(const std::function<std::string(const std::string&)>& show_page) {
+        std::string token = show_page("");
+        while (!token.empty()) {
+            std::cout << "Enter for the next page, 0 to stop: ";
+            std::string answer;
+            std::getline(std::cin, answer);
+            if (answer == "0") {
+                break;
+            }
+            token = show_page(token);
+        }
+    }
+
+    struct StageResult {
+        size_t files = 0;
+        size_t rows = 0;
+        size_t imported = 0;
+        double seconds = 0.0;
+    };
+
+    // Files of a directory import as (choice, path) pairs. A manifest.txt with
+    // "<entity> <file>" lines lists them explicitly; otherwise every .csv,
+    // .json and .ndjson file, plain or compressed, is assigned by the entity
+    // its name starts with.
+    std::optional<std::vector<std::pair<std::string, std::string>>> listImportFiles(const std::string& directory) {
+        namespace fs = std::filesystem;
+        if (!fs::is_directory(directory)) {
+            spdlog::error("Directory not found: {}", directory);
+            return std::nullopt;
+        }
+        std::vector<std::pair<std::string, std::string>> files;
+        fs::path manifest = fs::path(directory) / "manifest.txt";
+        if (fs::exists(manifest)) {
+            std::ifstream input(manifest);
+            std::string line;
+            while (std::getline(input, line)) {
+                std::istringstream fields(line);
+                std::string entity;
+                std::string file;
+                if (!(fields >> entity) || entity[0] == '#') continue;
+                std::getline(fields >> std::ws, file);
+                std::string choice = entityChoice(entity);
+                if (choice.empty() || file.empty()) {
+                    spdlog::warn("Skipping manifest line: {}", line);
+                    continue;
+                }
+                files.emplace_back(choice, (fs::path(directory) / file).string());
+            }
+            spdlog::info("Manifest lists {} files", files.size());
+            return files;
+        }
+        for (const auto& entry : fs::directory_iterator(directory)) {
+            if (!entry.is_regular_file()) continue;
+            // authors.csv.gz is a .csv file compressed with gzip
+            fs::path name = entry.path().filename();
+            if (name.extension() == ".gz" || name.extension() == ".zst") name = name.stem();
+            std::string extension = name.extension().string();
+            if (extension != ".csv" && extension != ".json" && extension != ".ndjson" && extension != ".jsonl") continue;
+            std::string choice = entityChoice(entry.path().filename().string());
+            if (choice.empty()) {
+                spdlog::warn("Skipping file of unknown entity: {}", entry.path().string());
+                continue;
+            }
+            files.emplace_back(choice, entry.path().string());
+        }
+        // Shards are loaded in name order
+        std::sort(files.begin(), files.end());
+        spdlog::info("Found {} files to import", files.size());
+        return files;
+    }
+}
 
 inline bool file_exist(const std::string& name) {
     FILE* file = nullptr;
@@ -18,17 +150,118 @@ inline bool file_exist(const std::string& name) {
     return false;
 }
 
-Library::Library(const std::string& db_path, const std::string& data_path)
-    : book_repo_(db_path), author_repo_(db_path), publisher_repo_(db_path),
-    genre_repo_(db_path), joiner_(db_path), data_path_(data_path) {
+Library::Library(const std::string& db_path, const std::string& data_path, size_t max_readers,
+    const StorageProfile& profile)
+    : pool_(db_path, max_readers, profile), index_advisor_(pool_), checkpoints_(pool_), book_repo_(pool_, index_advisor_),
+    author_repo_(pool_, index_advisor_), publisher_repo_(pool_, index_advisor_),
+    genre_repo_(pool_, index_advisor_), joiner_(pool_), data_path_(data_path) {
+    // Only counts are reported, so imported rows are not kept in memory
+    bulk_options_.keep_rows = false;
     if (!author_repo_.initialize() || !genre_repo_.initialize() || !publisher_repo_.initialize() ||
-         !book_repo_.initialize()) {
+         !book_repo_.initialize() || !checkpoints_.initialize()) {
         spdlog::error("Failed to initialize repositories");
         throw std::runtime_error("Repository initialization failed");
     }
     spdlog::info("Library initialized with data path: {}", data_path_);
 }
 
+bool Library::setStorageProfile(const std::string& name) {
+    auto profile = StorageProfile::byName(name);
+    if (!profile) {
+        spdlog::warn("Unknown storage profile: {}", name);
+        return false;
+    }
+    pool_.applyProfile(*profile);
+    return true;
+}
+
+void Library::setBulkImport(bool enabled, size_t batch_size) {
+    bulk_options_.enabled = enabled;
+    bulk_options_.batch_size = batch_size > 0 ? batch_size : 1;
+    spdlog::info("Bulk import {} (batch size {})", enabled ? "enabled" : "disabled", bulk_options_.batch_size);
+}
+
+void Library::setResumableImport(bool enabled) {
+    bulk_options_.checkpoints = enabled ? &checkpoints_ : nullptr;
+    spdlog::info("Import checkpoints {}", enabled ? "enabled" : "disabled");
+}
+
+void Library::setImportThreads(size_t workers) {
+    bulk_options_.workers = workers > 0 ? workers : 1;
+    spdlog::info("CSV and NDJSON imports use {} parser thread(s)", bulk_options_.workers);
+}
+
+std::optional<ImportStats> Library::importFile(const std::string& file_path, const std::string& choice) {
+    // Checked before .json, which ".ndjson" also contains
+    if (file_path.find(".ndjson") != std::string::npos || file_path.find(".jsonl") != std::string::npos) {
+        if (choice == "1") {
+            JSONBookReader reader(file_path, book_repo_, bulk_options_);
+            reader.loadFromNDJSON();
+            return reader.stats();
+        }
+        else if (choice == "2") {
+            JSONAuthorReader reader(file_path, author_repo_, bulk_options_);
+            reader.loadFromNDJSON();
+            return reader.stats();
+        }
+        else if (choice == "3") {
+            JSONPublisherReader reader(file_path, publisher_repo_, bulk_options_);
+            reader.loadFromNDJSON();
+            return reader.stats();
+        }
+        else if (choice == "4") {
+            JSONGenreReader reader(file_path, genre_repo_, bulk_options_);
+            reader.loadFromNDJSON();
+            return reader.stats();
+        }
+    }
+    else if (file_path.find(".json") != std::string::npos) {
+        if (choice == "1") {
+            JSONBookReader reader(file_path, book_repo_, bulk_options_);
+            reader.loadFromJSON();
+            return reader.stats();
+        }
+        else if (choice == "2") {
+            JSONAuthorReader reader(file_path, author_repo_, bulk_options_);
+            reader.loadFromJSON();
+            return reader.stats();
+        }
+        else if (choice == "3") {
+            JSONPublisherReader reader(file_path, publisher_repo_, bulk_options_);
+            reader.loadFromJSON();
+            return reader.stats();
+        }
+        else if (choice == "4") {
+            JSONGenreReader reader(file_path, genre_repo_, bulk_options_);
+            reader.loadFromJSON();
+            return reader.stats();
+        }
+    }
+    else if (file_path.find(".csv") != std::string::npos) {
+        if (choice == "1") {
+            CSVBookReader reader(file_path, book_repo_, bulk_options_);
+            reader.loadFromCSV();
+            return reader.stats();
+        }
+        else if (choice == "2") {
+            CSVAuthorReader reader(file_path, author_repo_, bulk_options_);
+            reader.loadFromCSV();
+            return reader.stats();
+        }
+        else if (choice == "3") {
+            CSVPublisherReader reader(file_path, publisher_repo_, bulk_options_);
+            reader.loadFromCSV();
+            return reader.stats();
+        }
+        else if (choice == "4") {
+            CSVGenreReader reader(file_path, genre_repo_, bulk_options_);
+            reader.loadFromCSV();
+            return reader.stats();
+        }
+    }
+    return std::nullopt;
+}
+
 bool Library::load(const std::string& path, const std::string& choice) {
     std::string full_path = data_path_ + path;
     spdlog::info("Loading file: {}", full_path);
@@ -39,70 +272,18 @@ bool Library::load(const std::string& path, const std::string& choice) {
             std::cout << "File '" << full_path << "' not found\n";
             return false;
         }
+        ScopedStorageProfile profile(pool_, StorageProfile::bulkLoad());
 
-        if (file_path.find(".json") != std::string::npos) {
-            if (choice == "1") {
-                JSONBookReader reader(full_path, book_repo_);
-                auto data = reader.loadFromJSON();
-                spdlog::info("Imported {} books from JSON", data.size());
-                std::cout << "Imported " << data.size() << " books\n";
-                return !data.empty();
-            }
-            else if (choice == "2") {
-                JSONAuthorReader reader(full_path, author_repo_);
-                auto data = reader.loadFromJSON();
-                spdlog::info("Imported {} authors from JSON", data.size());
-                std::cout << "Imported " << data.size() << " authors\n";
-                return !data.empty();
-            }
-            else if (choice == "3") {
-                JSONPublisherReader reader(full_path, publisher_repo_);
-                auto data = reader.loadFromJSON();
-                spdlog::info("Imported {} publishers from JSON", data.size());
-                std::cout << "Imported " << data.size() << " publishers\n";
-                return !data.empty();
-            }
-            else if (choice == "4") {
-                JSONGenreReader reader(full_path, genre_repo_);
-                auto data = reader.loadFromJSON();
-                spdlog::info("Imported {} genres from JSON", data.size());
-                std::cout << "Imported " << data.size() << " genres\n";
-                return !data.empty();
-            }
-        }
-        else if (file_path.find(".csv") != std::string::npos) {
-            if (choice == "1") {
-                CSVBookReader reader(full_path, book_repo_);
-                auto data = reader.loadFromCSV();
-                spdlog::info("Imported {} books from CSV", data.size());
-                std::cout << "Imported " << data.size() << " books\n";
-                return !data.empty();
-            }
-            else if (choice == "2") {
-                CSVAuthorReader reader(full_path, author_repo_);
-                auto data = reader.loadFromCSV();
-                spdlog::info("Imported {} authors from CSV", data.size());
-                std::cout << "Imported " << data.size() << " authors\n";
-                return !data.empty();
-            }
-            else if (choice == "3") {
-                CSVPublisherReader reader(full_path, publisher_repo_);
-                auto data = reader.loadFromCSV();
-                spdlog::info("Imported {} publishers from CSV", data.size());
-                std::cout << "Imported " << data.size() << " publishers\n";
-                return !data.empty();
-            } else if (choice == "4") {
-                CSVGenreReader reader(full_path, genre_repo_);
-                auto data = reader.loadFromCSV();
-                spdlog::info("Imported {} genres from CSV", data.size());
-                std::cout << "Imported " << data.size() << " genres\n";
-                return !data.empty();
-            }
+        auto stats = importFile(file_path, choice);
+        if (!stats) {
+            spdlog::error("Unsupported file format: {}", full_path);
+            std::cout << "Unsupported file format\n";
+            return false;
         }
-
-        spdlog::error("Unsupported file format: {}", full_path);
-        std::cout << "Unsupported file format\n";
-        return false;
+        std::string entity = entityName(choice);
+        spdlog::info("Imported {} {}s from {}", stats->imported, entity, full_path);
+        std::cout << "Imported " << stats->imported << " " << entity << "s\n";
+        return stats->imported > 0;
     }
     catch (const std::exception& e) {
         spdlog::error("Error loading file {}: {}", full_path, e.what());
@@ -111,6 +292,88 @@ bool Library::load(const std::string& path, const std::string& choice) {
     }
 }
 
+bool Library::loadDirectory(const std::string& path) {
+    std::string directory = data_path_ + path;
+    spdlog::info("Loading directory: {}", directory);
+    try {
+        auto files = listImportFiles(directory);
+        if (!files) {
+            std::cout << "Directory '" << directory << "' not found\n";
+            return false;
+        }
+        if (files->empty()) {
+            spdlog::warn("No importable files in {}", directory);
+            std::cout << "No importable files found\n";
+            return false;
+        }
+        ScopedStorageProfile profile(pool_, StorageProfile::bulkLoad());
+        auto started = std::chrono::steady_clock::now();
+
+        // Loads every shard of one entity in order; shards of the same
+        // entity share a repository and its dedup index, so they are not parallel
+        auto run_entity = [&](const std::string& choice, StageResult& result) {
+            auto entity_started = std::chrono::steady_clock::now();
+            for (const auto& file : *files) {
+                if (file.first != choice) continue;
+                auto stats = importFile(file.second, choice);
+                if (!stats) {
+                    spdlog::warn("Unsupported file format: {}", file.second);
+                    continue;
+                }
+                result.rows += stats->rows;
+                result.imported += stats->imported;
+                ++result.files;
+            }
+            result.seconds = secondsSince(entity_started);
+        };
+
+        // Stage 1: books reference these tables, so they are loaded first and side by side
+        std::map<std::string, StageResult> results = { {"1", {}}, {"2", {}}, {"3", {}}, {"4", {}} };
+        auto stage_started = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (const char* choice : { "2", "3", "4" }) {
+            threads.emplace_back(run_entity, std::string(choice), std::ref(results[choice]));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double reference_seconds = secondsSince(stage_started);
+
+        // Stage 2: book shards
+        stage_started = std::chrono::steady_clock::now();
+        run_entity("1", results["1"]);
+        double book_seconds = secondsSince(stage_started);
+
+        double total_seconds = secondsSince(started);
+        size_t rows = 0;
+        size_t imported = 0;
+        std::cout << "\nDirectory import report:\n";
+        for (const char* choice : { "2", "3", "4", "1" }) {
+            const StageResult& result = results[choice];
+            rows += result.rows;
+            imported += result.imported;
+            spdlog::info("{}: {} files, {} of {} rows imported in {:.2f}s",
+                entityName(choice), result.files, result.imported, result.rows, result.seconds);
+            std::cout << fmt::format("  {}s: {} of {} rows from {} file(s) in {:.2f}s\n",
+                entityName(choice), result.imported, result.rows, result.files, result.seconds);
+        }
+        double rows_per_second = total_seconds > 0 ? rows / total_seconds : 0.0;
+        spdlog::info("Directory import: {} of {} rows in {:.2f}s ({:.0f} rows/sec); critical path: "
+            "authors/publishers/genres {:.2f}s, books {:.2f}s",
+            imported, rows, total_seconds, rows_per_second, reference_seconds, book_seconds);
+        std::cout << fmt::format("  Stage 1 (authors, publishers, genres): {:.2f}s\n", reference_seconds)
+            << fmt::format("  Stage 2 (books): {:.2f}s\n", book_seconds)
+            << fmt::format("  Total: {} of {} rows in {:.2f}s ({:.0f} rows/sec)\n",
+                imported, rows, total_seconds, rows_per_second);
+        return imported > 0;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error loading directory {}: {}", directory, e.what());
+        std::cout << "Error loading directory: " << e.what() << "\n";
+        return false;
+    }
+}
+
 void Library::filter(const std::string& choice, const std::string& field, const std::string& direction) {
     spdlog::info("Filtering choice: {}, field: {}, direction: {}", choice, field, direction);
     try {
@@ -171,6 +434,135 @@ int Library::search(const std::string& choice, const std::string& field, const s
     }
 }
 
+int Library::fullTextSearch(const std::string& choice, const std::string& terms, size_t limit) {
+    spdlog::info("Full-text search choice: {}, terms: {}", choice, terms);
+    try {
+        int result = 0;
+        if (choice == "1") {
+            result = book_repo_.showSearch(terms, limit);
+        }
+        else if (choice == "2") {
+            result = author_repo_.showSearch(terms, limit);
+        }
+        else if (choice == "3") {
+            result = publisher_repo_.showSearch(terms, limit);
+        }
+        else if (choice == "4") {
+            result = genre_repo_.showSearch(terms, limit);
+        }
+        else {
+            spdlog::warn("Invalid search choice: {}", choice);
+            std::cout << "Invalid entity choice\n";
+            return 0;
+        }
+        if (result == 0) {
+            std::cout << "No results\n";
+        }
+        return result;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error searching: {}", e.what());
+        std::cout << "Error searching: " << e.what() << "\n";
+        return 0;
+    }
+}
+
+int Library::prefixSearch(const std::string& choice, const std::string& prefix, size_t limit) {
+    spdlog::info("Prefix search choice: {}, prefix: {}", choice, prefix);
+    try {
+        int result = 0;
+        if (choice == "1") {
+            result = book_repo_.showPrefix(prefix, limit);
+        }
+        else if (choice == "2") {
+            result = author_repo_.showPrefix(prefix, limit);
+        }
+        else if (choice == "3") {
+            result = publisher_repo_.showPrefix(prefix, limit);
+        }
+        else if (choice == "4") {
+            result = genre_repo_.showPrefix(prefix, limit);
+        }
+        else {
+            spdlog::warn("Invalid search choice: {}", choice);
+            std::cout << "Invalid entity choice\n";
+            return 0;
+        }
+        return result;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error searching: {}", e.what());
+        std::cout << "Error searching: " << e.what() << "\n";
+        return 0;
+    }
+}
+
+int Library::fuzzySearch(const std::string& choice, const std::string& text, size_t max_distance, size_t limit) {
+    spdlog::info("Fuzzy search choice: {}, text: {}, max distance: {}", choice, text, max_distance);
+    try {
+        int result = 0;
+        if (choice == "1") {
+            result = book_repo_.showSimilar(text, max_distance, limit);
+        }
+        else if (choice == "2") {
+            result = author_repo_.showSimilar(text, max_distance, limit);
+        }
+        else if (choice == "3") {
+            result = publisher_repo_.showSimilar(text, max_distance, limit);
+        }
+        else if (choice == "4") {
+            result = genre_repo_.showSimilar(text, max_distance, limit);
+        }
+        else {
+            spdlog::warn("Invalid search choice: {}", choice);
+            std::cout << "Invalid entity choice\n";
+            return 0;
+        }
+        if (result == 0) {
+            std::cout << "No results\n";
+        }
+        return result;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error searching: {}", e.what());
+        std::cout << "Error searching: " << e.what() << "\n";
+        return 0;
+    }
+}
+
+int Library::rangeSearch(const std::string& choice, const std::string& field, const std::string& op,
+    const std::string& from, const std::string& to) {
+    spdlog::info("Range search choice: {}, {} {} {} {}", choice, field, op, from, to);
+    try {
+        const long long low = rangeBound(choice, field, from);
+        const long long high = op == "between" ? rangeBound(choice, field, to) : 0;
+        int result = 0;
+        if (choice == "1") {
+            result = book_repo_.showRange(field, op, low, high);
+        }
+        else if (choice == "2") {
+            result = author_repo_.showRange(field, op, low, high);
+        }
+        else if (choice == "3") {
+            result = publisher_repo_.showRange(field, op, low, high);
+        }
+        else if (choice == "4") {
+            result = genre_repo_.showRange(field, op, low, high);
+        }
+        else {
+            spdlog::warn("Invalid search choice: {}", choice);
+            std::cout << "Invalid entity choice\n";
+            return 0;
+        }
+        return result;
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error searching: {}", e.what());
+        std::cout << "Error searching: " << e.what() << "\n";
+        return 0;
+    }
+}
+
 int Library::addRecord(const std::string& choice, const std::map<std::string, std::string>& record) {
     spdlog::info("Adding record for choice: {}", choice);
     try {
@@ -282,6 +674,61 @@ bool Library::deleteRecord(const std::string& choice, const std::string& field,
     }
 }
 
+std::string Library::showPage(const std::string& choice, const RowQuery& query, size_t page_size) {
+    try {
+        if (choice == "1") {
+            return book_repo_.showPage(query, page_size);
+        }
+        else if (choice == "2") {
+            return author_repo_.showPage(query, page_size);
+        }
+        else if (choice == "3") {
+            return publisher_repo_.showPage(query, page_size);
+        }
+        else if (choice == "4") {
+            return genre_repo_.showPage(query, page_size);
+        }
+        spdlog::warn("Invalid page choice: {}", choice);
+        std::cout << "Invalid entity choice\n";
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error displaying page: {}", e.what());
+        std::cout << "Error displaying: " << e.what() << "\n";
+    }
+    return "";
+}
+
+std::string Library::displayPage(const std::string& choice, size_t page_size, const std::string& token) {
+    spdlog::info("Displaying page for choice: {}, size: {}, after: '{}'", choice, page_size, token);
+    RowQuery query;
+    query.after = token;
+    return showPage(choice, query, page_size);
+}
+
+std::string Library::filterPage(const std::string& choice, const std::string& field, const std::string& direction,
+    size_t page_size, const std::string& token) {
+    spdlog::info("Filtering page for choice: {}, field: {}, direction: {}, after: '{}'", choice, field, direction, token);
+    if (direction != "up" && direction != "down") {
+        spdlog::error("Invalid sort direction: {}", direction);
+        return "";
+    }
+    RowQuery query;
+    query.order_by = field;
+    query.descending = direction == "down";
+    query.after = token;
+    return showPage(choice, query, page_size);
+}
+
+std::string Library::searchPage(const std::string& choice, const std::string& field, const std::string& value,
+    size_t page_size, const std::string& token) {
+    spdlog::info("Searching page for choice: {}, field: {}, value: {}, after: '{}'", choice, field, value, token);
+    RowQuery query;
+    query.field = field;
+    query.value = value;
+    query.after = token;
+    return showPage(choice, query, page_size);
+}
+
 void Library::displayAll(const std::string& choice) {
     spdlog::info("Displaying all records for choice: {}", choice);
     try {
@@ -308,6 +755,20 @@ void Library::displayAll(const std::string& choice) {
     }
 }
 
+void Library::reportStatementCache() {
+    pool_.logStatistics();
+}
+
+void Library::reportIndexes() {
+    index_advisor_.report();
+}
+
+int Library::createMissingIndexes() {
+    int created = index_advisor_.createMissingIndexes();
+    spdlog::info("Created {} missing indexes", created);
+    return created;
+}
+
 void Library::join(const std::string& choice) {
     spdlog::info("Joining for choice: {}", choice);
     try {
@@ -334,6 +795,7 @@ void Library::join(const std::string& choice) {
 void Library::exportData(const std::string& choice, const std::string& format) {
     spdlog::info("Exporting data for choice: {}, format: {}", choice, format);
     try {
+        ScopedStorageProfile profile(pool_, StorageProfile::readOnlyAnalytics());
         if (choice == "1") {
             book_repo_.exportData(format);
         }
@@ -415,18 +877,168 @@ void searchMenu(Library& library) {
     std::getline(std::cin, query);
     spdlog::info("Searching {} by {}: {}", entity, field, query);
 
+    if (size_t page_size = askPageSize()) {
+        pageThrough([&](const std::string& token) {
+            return library.searchPage(choice, field, query, page_size, token);
+        });
+        return;
+    }
     library.search(choice, field, query);
 }
 
 
+void fullTextSearchMenu(Library& library) {
+    spdlog::info("Starting full-text search menu");
+    std::map<std::string, std::string> entity_types = {
+        {"1", "book"}, {"2", "author"}, {"3", "publisher"}, {"4", "genre"}
+    };
+
+    std::cout << "\nFull-text search in:\n"
+        << "1. book (title, description)\n2. author (name, biography)\n"
+        << "3. publisher (name, address)\n4. genre (title, description)\n0. back\n"
+        << "Select entity: ";
+    std::string choice;
+    std::getline(std::cin, choice);
+
+    if (choice == "0") {
+        return;
+    }
+    if (entity_types.find(choice) == entity_types.end()) {
+        spdlog::warn("Invalid entity choice: {}", choice);
+        std::cout << "Invalid entity choice\n";
+        return;
+    }
+
+    std::cout << "Enter words (end a word with * to match a prefix): ";
+    std::string terms;
+    std::getline(std::cin, terms);
+    library.fullTextSearch(choice, terms);
+}
+
+void nameSearchMenu(Library& library) {
+    spdlog::info("Starting name search menu");
+    std::map<std::string, std::string> entity_types = {
+        {"1", "book"}, {"2", "author"}, {"3", "publisher"}, {"4", "genre"}
+    };
+
+    std::cout << "\nFind by name:\n"
+        << "1. book (title)\n2. author (full name)\n3. publisher (name)\n4. genre (title)\n0. back\n"
+        << "Select entity: ";
+    std::string choice;
+    std::getline(std::cin, choice);
+
+    if (choice == "0") {
+        return;
+    }
+    if (entity_types.find(choice) == entity_types.end()) {
+        spdlog::warn("Invalid entity choice: {}", choice);
+        std::cout << "Invalid entity choice\n";
+        return;
+    }
+
+    std::cout << "1. Starts with\n2. Similar (allows typos, 3+ characters)\nSelect mode: ";
+    std::string mode;
+    std::getline(std::cin, mode);
+    if (mode != "1" && mode != "2") {
+        spdlog::warn("Invalid name search mode: {}", mode);
+        std::cout << "Invalid mode\n";
+        return;
+    }
+
+    std::cout << "Enter " << (mode == "1" ? "the beginning of the name: " : "the name (at least 3 characters): ");
+    std::string text;
+    std::getline(std::cin, text);
+    if (mode == "1") {
+        library.prefixSearch(choice, text);
+        return;
+    }
+
+    std::cout << "Maximum number of typos (Enter for 2): ";
+    std::string input;
+    std::getline(std::cin, input);
+    size_t max_distance = 2;
+    if (!input.empty()) {
+        try {
+            max_distance = std::stoul(input);
+        }
+        catch (const std::exception&) {
+            spdlog::warn("Invalid typo count: {}", input);
+            std::cout << "Invalid number, using 2\n";
+        }
+    }
+    library.fuzzySearch(choice, text, max_distance);
+}
+
+void rangeSearchMenu(Library& library) {
+    spdlog::info("Starting range search menu");
+    std::map<std::string, std::string> entity_types = {
+        {"1", "book"}, {"2", "author"}
+    };
+    std::map<std::string, std::map<std::string, std::string>> field_options = {
+        {"book", {{"1", "year"}, {"2", "pages"}, {"3", "author_id"}, {"4", "genre_id"}, {"5", "publisher_id"}, {"6", "id"}}},
+        {"author", {{"1", "birth_date"}, {"2", "death_date"}, {"3", "id"}}}
+    };
+    std::map<std::string, std::string> operators = {
+        {"1", "between"}, {"2", "<"}, {"3", "<="}, {"4", ">"}, {"5", ">="}, {"6", "="}
+    };
+
+    std::cout << "\nRange search in:\n1. book\n2. author\n0. back\nSelect entity: ";
+    std::string choice;
+    std::getline(std::cin, choice);
+    if (choice == "0") {
+        return;
+    }
+    if (entity_types.find(choice) == entity_types.end()) {
+        spdlog::warn("Invalid entity choice: {}", choice);
+        std::cout << "Invalid entity choice\n";
+        return;
+    }
+
+    std::string entity = entity_types[choice];
+    std::cout << "\nSearch " << entity << " by:\n";
+    for (const auto& pair : field_options[entity]) {
+        std::cout << pair.first << ". " << pair.second << "\n";
+    }
+    std::cout << "Select field: ";
+    std::string field_choice;
+    std::getline(std::cin, field_choice);
+    if (field_options[entity].find(field_choice) == field_options[entity].end()) {
+        spdlog::warn("Invalid field choice: {}", field_choice);
+        std::cout << "Invalid field choice\n";
+        return;
+    }
+    std::string field = field_options[entity][field_choice];
+
+    std::cout << "1. between\n2. <\n3. <=\n4. >\n5. >=\n6. =\nSelect comparison: ";
+    std::string op_choice;
+    std::getline(std::cin, op_choice);
+    if (operators.find(op_choice) == operators.end()) {
+        spdlog::warn("Invalid comparison choice: {}", op_choice);
+        std::cout << "Invalid comparison choice\n";
+        return;
+    }
+    std::string op = operators[op_choice];
+
+    const char* format = field == "birth_date" || field == "death_date" ? " (dd.mm.yyyy)" : "";
+    std::cout << (op == "between" ? "From" : "Value") << format << ": ";
+    std::string from;
+    std::getline(std::cin, from);
+    std::string to;
+    if (op == "between") {
+        std::cout << "To" << format << ": ";
+        std::getline(std::cin, to);
+    }
+    library.rangeSearch(choice, field, op, from, to);
+}
+
 void importData(Library& library) {
     spdlog::info("Starting data import");
     std::map<std::string, std::string> entity_types = {
-        {"1", "book"}, {"2", "author"}, {"3", "publisher"}, {"4", "genre"}
+        {"1", "book"}, {"2", "author"}, {"3", "publisher"}, {"4", "genre"}, {"5", "directory"}
     };
 
     std::cout << "\nImport Data for:\n"
-        << "1. Books\n2. Authors\n3. Publishers\n4. Genres\n0. back\n"
+        << "1. Books\n2. Authors\n3. Publishers\n4. Genres\n5. Directory (all entities)\n0. back\n"
         << "Select entity: ";
     std::string choice;
     std::getline(std::cin, choice);
@@ -442,7 +1054,7 @@ void importData(Library& library) {
         return;
     }
 
-    std::cout << "Enter path to CSV/JSON file: ";
+    std::cout << (choice == "5" ? "Enter path to directory: " : "Enter path to CSV/JSON/NDJSON file: ");
     std::string path;
     std::getline(std::cin, path);
     if (path.empty()) {
@@ -451,7 +1063,51 @@ void importData(Library& library) {
         return;
     }
 
-    library.load(path, choice);
+    std::cout << "Use bulk import mode? (y/n): ";
+    std::string bulk;
+    std::getline(std::cin, bulk);
+    if (bulk == "y" || bulk == "Y") {
+        std::cout << "Enter batch size (default 1000): ";
+        std::string batch;
+        std::getline(std::cin, batch);
+        size_t batch_size = 1000;
+        try {
+            if (!batch.empty()) batch_size = std::stoul(batch);
+        }
+        catch (const std::exception&) {
+            spdlog::warn("Invalid batch size: {}, using default", batch);
+        }
+        library.setBulkImport(true, batch_size);
+
+        std::cout << "Resume interrupted CSV/NDJSON imports from checkpoints? (y/n): ";
+        std::string resume;
+        std::getline(std::cin, resume);
+        library.setResumableImport(resume == "y" || resume == "Y");
+    }
+    else {
+        library.setBulkImport(false);
+    }
+
+    // Leave one core for the writing thread
+    size_t default_threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    std::cout << "Enter number of CSV/NDJSON parser threads (default " << default_threads << "): ";
+    std::string threads;
+    std::getline(std::cin, threads);
+    size_t workers = default_threads;
+    try {
+        if (!threads.empty()) workers = std::stoul(threads);
+    }
+    catch (const std::exception&) {
+        spdlog::warn("Invalid thread count: {}, using default", threads);
+    }
+    library.setImportThreads(workers);
+
+    if (choice == "5") {
+        library.loadDirectory(path);
+    }
+    else {
+        library.load(path, choice);
+    }
 }
 
 void addRecordMenu(Library& library) {
@@ -710,16 +1366,20 @@ void filteringMenu(Library& library) {
     std::getline(std::cin, dir);
     spdlog::debug("User selected direction: {}", dir);
 
-    if (dir == "1") {
-        library.filter(choice, field_options[entity][field_choice], "up");
-    }
-    else if (dir == "2") {
-        library.filter(choice, field_options[entity][field_choice], "down");
-    }
-    else {
+    if (dir != "1" && dir != "2") {
         spdlog::warn("Invalid direction choice: {}", dir);
         std::cout << "Invalid direction choice\n";
+        return;
     }
+    std::string field = field_options[entity][field_choice];
+    std::string direction = dir == "1" ? "up" : "down";
+    if (size_t page_size = askPageSize()) {
+        pageThrough([&](const std::string& token) {
+            return library.filterPage(choice, field, direction, page_size, token);
+        });
+        return;
+    }
+    library.filter(choice, field, direction);
 }
 
 void displayRecordsMenu(Library& library) {
@@ -746,7 +1406,14 @@ void displayRecordsMenu(Library& library) {
     }
 
     std::string entity = entity_types[choice];
-    library.displayAll(choice);
+    if (size_t page_size = askPageSize()) {
+        pageThrough([&](const std::string& token) {
+            return library.displayPage(choice, page_size, token);
+        });
+    }
+    else {
+        library.displayAll(choice);
+    }
     spdlog::info("Displayed {} records", entity);
 }
 
@@ -755,7 +1422,7 @@ void exportDataMenu(Library& library) {
     std::map<std::string, std::string> entity_types = {
         {"1", "book"}, {"2", "author"}, {"3", "publisher"}, {"4", "genre"}
     };
-    std::map<std::string, std::string> file_types = { {"1", "json"}, {"2", "csv"} };
+    std::map<std::string, std::string> file_types = { {"1", "json"}, {"2", "csv"}, {"3", "json-compact"}, {"4", "ndjson"} };
 
     std::cout << "\nExport data for:\n";
     for (const auto& pair : entity_types) {
@@ -797,13 +1464,39 @@ void exportDataMenu(Library& library) {
     spdlog::info("Exported {} data in {}", entity, format);
 }
 
+void storageProfileMenu(Library& library) {
+    spdlog::info("Starting storage profile menu");
+    auto names = StorageProfile::names();
+    std::cout << "\nStorage profile:\n";
+    for (size_t i = 0; i < names.size(); ++i) {
+        std::cout << i + 1 << ". " << names[i] << "\n";
+    }
+    std::cout << "0. back\nSelect profile: ";
+    std::string choice;
+    std::getline(std::cin, choice);
+
+    if (choice == "0") {
+        return;
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (choice == std::to_string(i + 1)) {
+            library.setStorageProfile(names[i]);
+            std::cout << "Storage profile set to " << names[i] << "\n";
+            return;
+        }
+    }
+    spdlog::warn("Invalid profile choice: {}", choice);
+    std::cout << "Invalid profile choice\n";
+}
+
 void mainMenu(Library& library) {
     spdlog::info("Starting main menu");
     while (true) {
         std::cout << "\nLibrary Management System:\n"
             << "1. Import data\n2. Display All Records\n3. Add Record\n4. Update Record\n"
             << "5. Delete Record\n6. Search Records\n7. Filter Records\n8. Get more information\n"
-            << "9. Export data\n0. Exit\nSelect an option: ";
+            << "9. Export data\n10. Create missing indexes\n11. Storage profile\n12. Full-text search\n13. Find by name\n14. Range search\n"
+            << "0. Exit\nSelect an option: ";
         std::string choice;
         std::getline(std::cin, choice);
         spdlog::debug("User selected: {}", choice);
@@ -835,8 +1528,26 @@ void mainMenu(Library& library) {
         else if (choice == "9") {
             exportDataMenu(library);
         }
+        else if (choice == "10") {
+            int created = library.createMissingIndexes();
+            std::cout << "Created " << created << " indexes\n";
+        }
+        else if (choice == "11") {
+            storageProfileMenu(library);
+        }
+        else if (choice == "12") {
+            fullTextSearchMenu(library);
+        }
+        else if (choice == "13") {
+            nameSearchMenu(library);
+        }
+        else if (choice == "14") {
+            rangeSearchMenu(library);
+        }
         else if (choice == "0") {
             spdlog::info("User chose to exit");
+            library.reportStatementCache();
+            library.reportIndexes();
             std::cout << "Goodbye!\n";
             break;
         }
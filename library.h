@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <optional>
 #include "C:/Users/kos22/CLionProjects/library/databases/book_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/databases/author_repository.h"
 #include "C:/Users/kos22/CLionProjects/library/databases/publisher_repository.h"
@@ -18,30 +19,68 @@
 
 class Library {
 private:
+    ConnectionPool pool_;
+    IndexAdvisor index_advisor_;
+    CheckpointStore checkpoints_;
     BookRepository book_repo_;
     AuthorRepository author_repo_;
     PublisherRepository publisher_repo_;
     GenreRepository genre_repo_;
     Joiner joiner_;
     std::string data_path_;
+    BulkImportOptions bulk_options_;
+    std::optional<ImportStats> importFile(const std::string& file_path, const std::string& choice);
+    std::string showPage(const std::string& choice, const RowQuery& query, size_t page_size);
 
 public:
-    Library(const std::string& db_path = "library.db", const std::string& data_path = "C:/Users/kos22/CLionProjects/library/data/");
+    Library(const std::string& db_path = "library.db", const std::string& data_path = "C:/Users/kos22/CLionProjects/library/data/",
+        size_t max_readers = 4, const StorageProfile& profile = StorageProfile::interactive());
+    bool setStorageProfile(const std::string& name);
+    void setBulkImport(bool enabled, size_t batch_size = 1000);
+    void setImportThreads(size_t workers);
+    // Bulk CSV imports record their progress and continue where an interrupted run stopped
+    void setResumableImport(bool enabled);
     bool load(const std::string& path, const std::string& choice);
+    // Imports every shard of a directory: authors, publishers and genres in parallel, then books
+    bool loadDirectory(const std::string& path);
     void filter(const std::string& choice, const std::string& field, const std::string& direction);
     int search(const std::string& choice, const std::string& field, const std::string& value);
+    // Ranked full-text search with snippets, best matches first
+    int fullTextSearch(const std::string& choice, const std::string& terms, size_t limit = 20);
+    // Name lookups through the trigram index: names starting with prefix, or
+    // names within max_distance typos of text. The typo search needs at least
+    // 3 characters and reports an error for shorter text.
+    int prefixSearch(const std::string& choice, const std::string& prefix, size_t limit = 20);
+    int fuzzySearch(const std::string& choice, const std::string& text, size_t max_distance = 2, size_t limit = 20);
+    // Range search on a numeric column (op =, <, <=, >, >= or between from and
+    // to); author birth_date and death_date take dd.mm.yyyy
+    int rangeSearch(const std::string& choice, const std::string& field, const std::string& op,
+        const std::string& from, const std::string& to = "");
     int addRecord(const std::string& choice, const std::map<std::string, std::string>& record);
     bool updateRecord(const std::string& choice, const std::string& field, const std::string& new_val,
         const int& id = -1);
     bool deleteRecord(const std::string& choice, const std::string& field, const std::string& value);
     void displayAll(const std::string& choice);
+    // Keyset-paginated listings: print page_size rows after token and return
+    // the token of the next page, empty after the last one
+    std::string displayPage(const std::string& choice, size_t page_size, const std::string& token = "");
+    std::string filterPage(const std::string& choice, const std::string& field, const std::string& direction,
+        size_t page_size, const std::string& token = "");
+    std::string searchPage(const std::string& choice, const std::string& field, const std::string& value,
+        size_t page_size, const std::string& token = "");
     void join(const std::string& choice);
     void exportData(const std::string& choice, const std::string& format);
+    void reportStatementCache();
+    void reportIndexes();
+    int createMissingIndexes();
   
 }; 
 // CLI function declarations
 void mainMenu(Library& library);
 void searchMenu(Library& library);
+void fullTextSearchMenu(Library& library);
+void nameSearchMenu(Library& library);
+void rangeSearchMenu(Library& library);
 void importData(Library& library);
 void addRecordMenu(Library& library);
 void updateRecordMenu(Library& library);
@@ -49,4 +88,5 @@ void deleteRecordMenu(Library& library);
 void filteringMenu(Library& library);
 void displayRecordsMenu(Library& library);
 void showFullInfo(Library& library);
-void exportDataMenu(Library& library);
\ No newline at end of file
+void exportDataMenu(Library& library);
+void storageProfileMenu(Library& library);
\ No newline at end of file
@@ -1,8 +1,7 @@
 #pragma once
 #include <string>
-#include <chrono>
-#include <ctime> 
 #include <stdexcept>
+#include "validation.h"
 
 struct Book {
     std::string title;
@@ -20,28 +19,21 @@ struct Book {
         validate();
     }
 
+    // Empty row filled in by Repository from the stored columns; it was
+    // validated when it was saved
+    explicit Book(TrustedRow)
+        : author_id(0), year(0), genre_id(0), publisher_id(0), pages(0), id(-1) {
+    }
+
 private:
     void validate() {
         if (title.empty()) {
             throw std::invalid_argument("Book title must not be empty");
         }
-        if (std::to_string(author_id).empty()) {
-            throw std::invalid_argument("Author field must not be empty");
-        }
-
-        auto now = std::chrono::system_clock::now();
-        auto now_t = std::chrono::system_clock::to_time_t(now);
-        std::tm now_tm = {};
-        errno_t err = localtime_s(&now_tm, &now_t);
 
-        if (err != 0) {
-            throw std::runtime_error("Failed to get local time");
-        }
-
-        int current_year = now_tm.tm_year + 1900;
-        if (year > current_year) {
+        // The clock is read once per process or import, not per row
+        if (year > validation::currentYear()) {
             throw std::invalid_argument("The year of publication cannot be in the future");
         }
-
     }
-};
\ No newline at end of file
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <stdexcept>
+#include "validation.h"
 
 struct Genre {
     std::string title;
@@ -12,10 +13,15 @@ struct Genre {
         validate();
     }
 
+    // Empty row filled in by Repository from the stored columns; it was
+    // validated when it was saved
+    explicit Genre(TrustedRow) : id(-1) {
+    }
+
 private:
     void validate() {
         if (title.empty()) {
             throw std::invalid_argument("Genre name must not be empty");
         }
     }
-};
\ No newline at end of file
+};
@@ -1,7 +1,7 @@
 #pragma once
 #include <string>
 #include <stdexcept>
-#include <regex>
+#include "validation.h"
 
 struct Publisher {
     std::string name;
@@ -15,14 +15,18 @@ struct Publisher {
         validate();
     }
 
+    // Empty row filled in by Repository from the stored columns; it was
+    // validated when it was saved
+    explicit Publisher(TrustedRow) : id(-1) {
+    }
+
 private:
     void validate() {
         if (name.empty()) {
             throw std::invalid_argument("Publisher name must not be empty");
         }
-        std::regex email_pattern(R"(^\S+@\S+\.\S+$)");
-        if (!std::regex_match(mail, email_pattern)) {
+        if (!validation::isValidEmail(mail)) {
             throw std::invalid_argument("Incorrect mail");
         }
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Tag for the model constructors used when hydrating rows read back from
+// the database. Those rows were validated when they were stored, so the
+// checks are skipped.
+struct TrustedRow {};
+inline constexpr TrustedRow trusted_row{};
+
+namespace validation {
+    // Dates are kept as yyyymmdd integers (31.07.1965 -> 19650731), which
+    // compare in calendar order; 0 means no date
+    using CompactDate = int;
+
+    inline CompactDate computeToday() {
+        auto now_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm now_tm = {};
+        if (localtime_s(&now_tm, &now_t) != 0) {
+            throw std::runtime_error("Failed to get local time");
+        }
+        return (now_tm.tm_year + 1900) * 10000 + (now_tm.tm_mon + 1) * 100 + now_tm.tm_mday;
+    }
+
+    inline std::atomic<CompactDate>& cachedToday() {
+        static std::atomic<CompactDate> today{ computeToday() };
+        return today;
+    }
+
+    // Reads the clock again; called at the start of every import so a
+    // long-running process does not keep yesterday's date
+    inline void refreshClock() {
+        cachedToday().store(computeToday(), std::memory_order_relaxed);
+    }
+
+    // Local date, read from the clock once per process or import
+    inline CompactDate today() {
+        return cachedToday().load(std::memory_order_relaxed);
+    }
+
+    inline int currentYear() {
+        return today() / 10000;
+    }
+
+    inline bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    inline int daysInMonth(int year, int month) {
+        static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+    }
+
+    // Parses d.m.yyyy / dd.mm.yyyy; returns 0 for malformed or impossible dates
+    inline CompactDate tryParseDate(std::string_view text) {
+        size_t pos = 0;
+        auto number = [&](size_t min_digits, size_t max_digits) {
+            int value = 0;
+            size_t digits = 0;
+            while (pos < text.size() && digits < max_digits && text[pos] >= '0' && text[pos] <= '9') {
+                value = value * 10 + (text[pos] - '0');
+                ++pos;
+                ++digits;
+            }
+            return digits >= min_digits ? value : -1;
+        };
+        int day = number(1, 2);
+        if (day < 0 || pos >= text.size() || text[pos++] != '.') return 0;
+        int month = number(1, 2);
+        if (month < 0 || pos >= text.size() || text[pos++] != '.') return 0;
+        int year = number(4, 4);
+        if (year < 0 || pos != text.size()) return 0;
+        if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) return 0;
+        return year * 10000 + month * 100 + day;
+    }
+
+    // Single-pass equivalent of std::regex_match(mail, std::regex(R"(^\S+@\S+\.\S+$)")):
+    // no whitespace, and some '@' after the first character with a '.' at
+    // least two characters later and at least one character before the end
+    inline bool isValidEmail(std::string_view mail) {
+        size_t first_at = std::string_view::npos;
+        size_t last_dot = std::string_view::npos;
+        for (size_t i = 0; i < mail.size(); ++i) {
+            char c = mail[i];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r') return false;
+            if (c == '@' && i >= 1 && first_at == std::string_view::npos) first_at = i;
+            if (c == '.' && i + 1 < mail.size()) last_dot = i;
+        }
+        return first_at != std::string_view::npos &&
+            last_dot != std::string_view::npos && last_dot >= first_at + 2;
+    }
+
+    // Throws std::invalid_argument for anything tryParseDate rejects
+    inline CompactDate parseDate(std::string_view text) {
+        CompactDate date = tryParseDate(text);
+        if (date == 0) {
+            throw std::invalid_argument("Invalid date format: " + std::string(text));
+        }
+        return date;
+    }
+}
@@ -0,0 +1,149 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+#include "C:/Users/kos22/CLionProjects/library/import/import_pipeline.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool condition, const char* what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+
+    using Row = std::vector<std::string>;
+
+    struct RowCollector {
+        std::vector<Row> rows;
+        void add(Row& row, const ImportPosition&) { rows.push_back(std::move(row)); }
+    };
+
+    std::vector<Row> importRows(const std::string& path, size_t workers, size_t chunk_size) {
+        RecordSource source(path, RecordFormat::CSV, chunk_size);
+        ImportPipeline<Row> pipeline(workers, 4);
+        RowCollector collector;
+        pipeline.run(source, csvChunkParser<Row>(2, [](const std::vector<std::string_view>& fields) {
+            return Row(fields.begin(), fields.end());
+        }), collector);
+        return collector.rows;
+    }
+
+    // Row number of the RecordError the import stops with, 0 if it finishes
+    size_t failingRow(const std::string& path, size_t workers, size_t chunk_size, size_t& rows_written) {
+        RecordSource source(path, RecordFormat::CSV, chunk_size);
+        ImportPipeline<Row> pipeline(workers, 4);
+        RowCollector collector;
+        size_t row = 0;
+        try {
+            pipeline.run(source, csvChunkParser<Row>(2, [](const std::vector<std::string_view>& fields) {
+                return Row(fields.begin(), fields.end());
+            }), collector);
+        }
+        catch (const RecordError& e) {
+            row = e.row();
+        }
+        rows_written = collector.rows.size();
+        return row;
+    }
+}
+
+int main() {
+    spdlog::set_level(spdlog::level::err);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "library_csv_chunk_test.csv";
+
+    // A stray quote inside an unquoted field, then quoted fields spanning
+    // lines and holding escaped quotes; chunks must never end inside them
+    std::string csv = "title,pages\n";
+    for (int i = 0; i < 50; ++i) {
+        csv += "12\" Vinyl " + std::to_string(i) + "," + std::to_string(i) + "\n";
+        csv += "\"Two\nlines, \"\"quoted\"\"\"," + std::to_string(i) + "\n";
+        csv += "  \"A\"\"\nB\" tail,x\"y\n";
+    }
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << csv;
+    }
+
+    std::vector<Row> expected;
+    CSVTokenizer tokenizer(std::string_view(csv).substr(csv.find('\n') + 1));
+    while (tokenizer.next()) {
+        expected.emplace_back(tokenizer.fields().begin(), tokenizer.fields().end());
+    }
+    check(expected.size() == 150, "tokenizer reads 150 rows");
+
+    for (size_t chunk_size : { 1, 7, 16, 64 }) {
+        check(importRows(path.string(), 1, chunk_size) == expected, "one worker matches the whole-file tokenizer");
+        check(importRows(path.string(), 4, chunk_size) == expected, "four workers match the whole-file tokenizer");
+    }
+
+    // Quoted content is trimmed together with any text after the closing quote
+    {
+        CSVTokenizer quoted("\" Foo \",\"Foo\" bar,\"Foo\"\"s\"  \n");
+        check(quoted.next(), "quoted row is read");
+        check(quoted.fields() == std::vector<std::string_view>{ "Foo", "Foo bar", "Foo\"s" },
+            "quoted fields are trimmed with their tail");
+    }
+
+    // An opening quote that is never closed stops the import at its row,
+    // whether the file ends first or the field outgrows the size limit,
+    // for mapped and for decompressed input
+    const std::filesystem::path gz_path = std::filesystem::temp_directory_path() / "library_csv_chunk_test.csv.gz";
+    for (size_t rows_after : { size_t(10), max_quoted_field_size / 4 }) {
+        std::string broken = "title,pages\n";
+        for (int i = 0; i < 20; ++i) {
+            broken += "Book " + std::to_string(i) + "," + std::to_string(i) + "\n";
+        }
+        broken += "\"Broken title,21\n";
+        for (size_t i = 0; i < rows_after; ++i) {
+            broken += "Book,1\n";
+        }
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << broken;
+        }
+        gzFile gz = gzopen(gz_path.string().c_str(), "wb");
+        gzwrite(gz, broken.data(), static_cast<unsigned>(broken.size()));
+        gzclose(gz);
+        for (const auto& file : { path, gz_path }) {
+            for (size_t chunk_size : { 64, 1 << 20 }) {
+                for (size_t workers : { 1, 4 }) {
+                    size_t rows_written = 0;
+                    check(failingRow(file.string(), workers, chunk_size, rows_written) == 21, "unterminated quote fails at its row");
+                    check(rows_written == 20, "rows before the unterminated quote are written");
+                }
+            }
+        }
+    }
+
+    // Records ended by a lone \r are split into chunks like \n-ended ones,
+    // and the header stops at its own \r
+    std::string cr_csv = "title,pages\r";
+    std::vector<Row> cr_expected;
+    for (int i = 0; i < 1000; ++i) {
+        cr_csv += "Book " + std::to_string(i) + "," + std::to_string(i) + "\r";
+        cr_expected.push_back(Row{ "Book " + std::to_string(i), std::to_string(i) });
+    }
+    check(findRecordEnd(cr_csv, 64) == cr_csv.find('\r', 64) + 1, "a lone \\r ends a record");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << cr_csv;
+    }
+    gzFile cr_gz = gzopen(gz_path.string().c_str(), "wb");
+    gzwrite(cr_gz, cr_csv.data(), static_cast<unsigned>(cr_csv.size()));
+    gzclose(cr_gz);
+    for (const auto& file : { path, gz_path }) {
+        check(importRows(file.string(), 1, 64) == cr_expected, "one worker reads \\r-ended records");
+        check(importRows(file.string(), 4, 64) == cr_expected, "four workers read \\r-ended records");
+    }
+
+    std::filesystem::remove(gz_path);
+    std::filesystem::remove(path);
+    if (failures == 0) {
+        std::printf("csv_chunk_test: all checks passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
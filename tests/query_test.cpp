@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include "C:/Users/kos22/CLionProjects/library/databases/book_repository.h"
+#include "C:/Users/kos22/CLionProjects/library/databases/author_repository.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool condition, const char* what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+}
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "library_query_test.db";
+    for (const char* suffix : { "", "-wal", "-shm" }) {
+        std::filesystem::remove(path.string() + suffix);
+    }
+
+    {
+        ConnectionPool pool(path.string(), 1);
+        IndexAdvisor advisor(pool);
+        BookRepository books(pool, advisor);
+        std::vector<Book> batch;
+        for (int i = 0; i < 10; ++i) {
+            batch.emplace_back("Book " + std::to_string(i), 1 + i % 2, "", 1950 + i, 1, 1, 100 + i);
+        }
+        check(books.saveBatch(batch) == 10, "new batch inserts every row");
+        // A batch of duplicates is not a failed batch
+        check(books.saveBatch(batch) == 0, "duplicate batch inserts nothing");
+
+        const Predicate recent = field(&Book::year) >= 1955;
+        check(books.select(Query<Book>().where(recent)).size() == 5, "year >= 1955 matches 5 rows");
+
+        // Every row OR p must keep the rows that fail p
+        check(books.select(Query<Book>().where(Predicate() || recent)).size() == 10, "all || p matches every row");
+        check(books.select(Query<Book>().where(recent || Predicate())).size() == 10, "p || all matches every row");
+        check(books.select(Query<Book>().where(Predicate() && recent)).size() == 5, "all && p matches p");
+        check(books.select(Query<Book>().where((Predicate() || recent) && field(&Book::author_id) == 1)).size() == 5,
+            "(all || p) && q matches q");
+
+        // update() rewrites the parsed date along with the text one
+        AuthorRepository authors(pool, advisor);
+        Author author("Ann Smith", "01.01.1900", "", "");
+        authors.save(author);
+        check(authors.update("date_of_birth", author.id, "01.01.1950"), "author birth date is updated");
+        check(authors.select(Query<Author>().where(field(&Author::birth_date) >= 19500101)).size() == 1,
+            "range query sees the updated birth date");
+    }
+
+    for (const char* suffix : { "", "-wal", "-shm" }) {
+        std::filesystem::remove(path.string() + suffix);
+    }
+    if (failures == 0) {
+        std::printf("query_test: all checks passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}